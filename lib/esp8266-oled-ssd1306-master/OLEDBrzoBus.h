@@ -0,0 +1,67 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 by Daniel Eichhorn
+ * Copyright (c) 2016 by Fabrice Weinberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OLEDBrzoBus_h
+#define OLEDBrzoBus_h
+
+#include "OLEDDisplayI2C.h"
+#include <brzo_i2c.h>
+
+#if F_CPU == 160000000L
+  #define BRZO_I2C_SPEED 1000
+#else
+  #define BRZO_I2C_SPEED 800
+#endif
+
+// brzo_i2c backend, writes straight from the caller's buffer so the
+// transaction size is only limited by OLEDDISPLAY_I2C_BUFFER
+class OLEDBrzoBus : public OLEDI2CBus {
+  private:
+      uint8_t             _sda;
+      uint8_t             _scl;
+
+  public:
+    OLEDBrzoBus(uint8_t _sda, uint8_t _scl) {
+      this->_sda = _sda;
+      this->_scl = _scl;
+    }
+
+    bool begin() {
+      brzo_i2c_setup(_sda, _scl, 0);
+      return true;
+    }
+
+    uint16_t maxTransfer() {
+      return OLEDDISPLAY_I2C_BUFFER;
+    }
+
+    bool write(uint8_t address, const uint8_t *data, uint16_t length) {
+      brzo_i2c_start_transaction(address, BRZO_I2C_SPEED);
+      brzo_i2c_write((uint8_t *) data, length, false);
+      return brzo_i2c_end_transaction() == 0;
+    }
+};
+
+#endif
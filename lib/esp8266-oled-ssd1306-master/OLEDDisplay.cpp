@@ -27,6 +27,256 @@
 
 #include "OLEDDisplay.h"
 
+// Page rows start on a word boundary, the row kernels below rely on it
+static_assert(DISPLAY_WIDTH % 4 == 0, "DISPLAY_WIDTH has to be a multiple of 4");
+static_assert(DISPLAY_WIDTH <= 128, "the controller drives at most 128 columns");
+static_assert(DISPLAY_HEIGHT % 8 == 0 && DISPLAY_HEIGHT >= 16 && DISPLAY_HEIGHT <= 64,
+              "DISPLAY_HEIGHT has to be whole pages, 16 to 64 rows");
+static_assert(OLEDDISPLAY_GLYPH_CACHE >= 0 && OLEDDISPLAY_GLYPH_CACHE <= 255,
+              "a font has at most 255 chars to cache");
+
+#ifdef OLEDDISPLAY_BLOCK_HASH
+static_assert(DISPLAY_WIDTH % OLEDDISPLAY_BLOCK_WIDTH == 0, "DISPLAY_WIDTH has to be whole blocks");
+
+// CRC-16/CCITT of one block of a page row, computed without a table
+static uint16_t blockCrc(const uint8_t *data) {
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < OLEDDISPLAY_BLOCK_WIDTH; i++) {
+    crc = (crc >> 8) | (crc << 8);
+    crc ^= data[i];
+    crc ^= (uint8_t) (crc & 0xFF) >> 4;
+    crc ^= crc << 12;
+    crc ^= (crc & 0xFF) << 5;
+  }
+  return crc;
+}
+#endif
+
+// 32 bits of a byte buffer. may_alias keeps the compiler from assuming the
+// word accesses below cannot touch the bytes around them.
+typedef uint32_t __attribute__((__may_alias__)) bufferWord;
+
+// Apply `mask` in `color` to `length` bytes of a page row. Whole words in
+// the middle are processed 32 bits at a time, unaligned edges byte-wise.
+static void maskRow(uint8_t *row, uint16_t length, uint8_t mask, OLEDDISPLAY_COLOR color) {
+  if (mask == 0xFF && color != INVERSE) {
+    // Nothing of the old content survives, plain stores
+    memset(row, color == WHITE ? 0xFF : 0x00, length);
+    return;
+  }
+
+  while (length && ((uintptr_t) row & 3)) {
+    switch (color) {
+      case WHITE:   *row |=  mask; break;
+      case BLACK:   *row &= ~mask; break;
+      case INVERSE: *row ^=  mask; break;
+    }
+    row++;
+    length--;
+  }
+
+  uint32_t wordMask = mask * 0x01010101UL;
+  bufferWord *words = (bufferWord *) row;
+  uint16_t count = length >> 2;
+  switch (color) {
+    case WHITE:   while (count--) *words++ |=  wordMask; break;
+    case BLACK:   while (count--) *words++ &= ~wordMask; break;
+    case INVERSE: while (count--) *words++ ^=  wordMask; break;
+  }
+
+  row = (uint8_t *) words;
+  length &= 3;
+  while (length--) {
+    switch (color) {
+      case WHITE:   *row |=  mask; break;
+      case BLACK:   *row &= ~mask; break;
+      case INVERSE: *row ^=  mask; break;
+    }
+    row++;
+  }
+}
+
+template <OLEDDISPLAY_COLOR Color>
+static inline void blend(uint8_t *dst, uint8_t bits) __attribute__((always_inline));
+
+template <OLEDDISPLAY_COLOR Color>
+static inline void blend(uint8_t *dst, uint8_t bits) {
+  switch (Color) {
+    case WHITE:   *dst |=  bits; break;
+    case BLACK:   *dst &= ~bits; break;
+    case INVERSE: *dst ^=  bits; break;
+  }
+}
+
+// A column-major bitmap of `rasterHeight` bytes per column, already clipped
+// to the visible columns. `dst` is the first visible column on page 0.
+struct BlitJob {
+  uint8_t        *dst;
+  const uint8_t  *src;
+  uint8_t         columns;
+  uint8_t         rasterHeight;
+  uint8_t         lastRows;     // bytes of the last column, fonts may cut it short
+  int8_t          page;         // page of the first raster row, may be negative
+  uint8_t         shift;        // bit offset of the bitmap within its pages
+};
+
+// Color and page alignment are fixed per call, so the inner loop is a
+// plain read-shift-blend. The visible pages are worked out once per
+// column. With a shift every raster row straddles two pages, each
+// destination byte combines the bits of two rows.
+template <OLEDDISPLAY_COLOR Color, bool Aligned>
+static void blit(const BlitJob &job) {
+  int16_t lastPage = Aligned ? job.page + job.rasterHeight - 1 : job.page + job.rasterHeight;
+  int16_t firstRow = _max((int16_t) 0, (int16_t) -job.page);
+  int16_t lastRow = _min(lastPage, (int16_t) (DISPLAY_PAGES - 1)) - job.page;
+
+  uint8_t *dst = job.dst;
+  const uint8_t *src = job.src;
+  for (uint8_t column = 0; column < job.columns; column++) {
+    uint8_t rows = column + 1 < job.columns ? job.rasterHeight : job.lastRows;
+
+    // Rows of this column that land on the display, the one past the
+    // last source row only receives the carry
+    int16_t endRow = _min(lastRow, (int16_t) (Aligned ? rows - 1 : rows));
+    uint8_t *out = dst + (job.page + firstRow) * DISPLAY_WIDTH;
+
+    if (Aligned) {
+      for (int16_t row = firstRow; row <= endRow; row++) {
+        blend<Color>(out, pgm_read_byte(src + row));
+        out += DISPLAY_WIDTH;
+      }
+    } else {
+      uint8_t carry = firstRow > 0 && firstRow <= rows ? pgm_read_byte(src + firstRow - 1) >> (8 - job.shift) : 0;
+      for (int16_t row = firstRow; row <= endRow; row++) {
+        uint8_t bits = row < rows ? pgm_read_byte(src + row) : 0;
+        blend<Color>(out, (uint8_t) (bits << job.shift) | carry);
+        carry = bits >> (8 - job.shift);
+        out += DISPLAY_WIDTH;
+      }
+    }
+
+    dst++;
+    src += job.rasterHeight;
+  }
+}
+
+// A row-major XBM, LSB first, and the part of it that is visible
+struct XbmJob {
+  const uint8_t  *xbm;
+  int16_t         widthInXbm;
+  int16_t         xMove;
+  int16_t         yMove;
+  int16_t         x0, x1;       // visible columns of the image
+  int16_t         y0, y1;       // visible rows of the image
+};
+
+template <OLEDDISPLAY_COLOR Color>
+static void blitXbm(uint8_t *buffer, const XbmJob &job) {
+  for (int16_t y = job.y0; y <= job.y1; y++) {
+    int16_t screenY = job.yMove + y;
+    uint8_t drawBit = 1 << (screenY & 7);
+    uint8_t *row = buffer + (screenY >> 3) * DISPLAY_WIDTH + job.xMove;
+    const uint8_t *line = job.xbm + y * job.widthInXbm;
+
+    uint8_t data = pgm_read_byte(line + (job.x0 >> 3)) >> (job.x0 & 7);
+    for (int16_t x = job.x0; x <= job.x1; x++) {
+      if (!(x & 7)) data = pgm_read_byte(line + (x >> 3)); // Read new data every 8 bit
+      if (data & 0x01) blend<Color>(row + x, drawBit);
+      data >>= 1;
+    }
+  }
+}
+
+// A whole frame moved by whole pages and a bit shift: destination page
+// p takes source page p - pages shifted down, plus the carry of the page
+// above it
+struct FrameJob {
+  const uint8_t  *src;           // first visible source column of page 0
+  uint8_t        *dst;           // first visible column of page 0
+  uint8_t         columns;
+  int8_t          pages;         // floor(y / 8)
+  uint8_t         shift;         // y & 7
+};
+
+template <OLEDDISPLAY_COLOR Color>
+static void blitFrame(const FrameJob &job) {
+  for (int8_t page = 0; page < DISPLAY_PAGES; page++) {
+    int8_t low = page - job.pages;
+    int8_t high = low - 1;
+    bool hasLow = low >= 0 && low < DISPLAY_PAGES;
+    bool hasHigh = job.shift && high >= 0 && high < DISPLAY_PAGES;
+    if (!hasLow && !hasHigh) continue;
+
+    uint8_t *out = job.dst + page * DISPLAY_WIDTH;
+    const uint8_t *lowRow = hasLow ? job.src + low * DISPLAY_WIDTH : NULL;
+    const uint8_t *highRow = hasHigh ? job.src + high * DISPLAY_WIDTH : NULL;
+    for (uint8_t x = 0; x < job.columns; x++) {
+      uint8_t bits = 0;
+      if (hasLow) bits = lowRow[x] << job.shift;
+      if (hasHigh) bits |= highRow[x] >> (8 - job.shift);
+      blend<Color>(out + x, bits);
+    }
+  }
+}
+
+// Converts one byte of UTF-8 to the extended ascii of the fonts, `last`
+// carries the previous byte. Returns 0 if the byte does not complete a char.
+static uint8_t decodeUtf8(uint8_t ascii, uint8_t &last) {
+  if ( ascii < 128 ) { // Standard ASCII-set 0..0x7F handling
+    last = 0;
+    return ascii;
+  }
+
+  uint8_t previous = last;   // get last char
+  last = ascii;
+
+  switch (previous) {    // conversion depnding on first UTF8-character
+    case 0xC2: return  (ascii);  break;
+    case 0xC3: return  (ascii | 0xC0);  break;
+    case 0x82: if (ascii == 0xAC) return (0x80);    // special case Euro-symbol
+  }
+
+  return  0; // otherwise: return zero, if character has to be ignored
+}
+
+static inline uint8_t textByte(const char *text, uint16_t index, uint8_t flags) {
+  return (flags & OLEDDISPLAY_TEXT_FLASH) ? pgm_read_byte(text + index) : text[index];
+}
+
+// Walks text in RAM or flash and yields the chars of the font encoding,
+// UTF-8 is decoded on the way instead of converting a copy up front
+class TextReader {
+  public:
+    TextReader(const char *text, uint16_t length, uint8_t flags) {
+      this->text = text;
+      this->length = length;
+      this->flags = flags;
+    }
+
+    bool next(uint8_t &code) {
+      while (this->index < this->length) {
+        uint8_t ascii = textByte(this->text, this->index++, this->flags);
+        if (!(this->flags & OLEDDISPLAY_TEXT_UTF8)) {
+          code = ascii;
+          return true;
+        }
+        code = decodeUtf8(ascii, this->last);
+        if (code) return true;
+      }
+      return false;
+    }
+
+    // Bytes of the source consumed so far
+    uint16_t position() const { return this->index; }
+
+  private:
+    const char  *text;
+    uint16_t     length;
+    uint8_t      flags;
+    uint16_t     index = 0;
+    uint8_t      last  = 0;
+};
+
 bool OLEDDisplay::init() {
   if (!this->connect()) {
     DEBUG_OLEDDISPLAY("[OLEDDISPLAY][init] Can't establish connection to display\n");
@@ -47,6 +297,14 @@ bool OLEDDisplay::init() {
   }
   #endif
 
+  // The fresh buffer holds garbage everywhere, the first clear() wipes it all
+  for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+    dirtyMinX[page] = DISPLAY_WIDTH;
+    dirtyMaxX[page] = 0;
+    contentMinX[page] = 0;
+    contentMaxX[page] = DISPLAY_WIDTH - 1;
+  }
+
   sendInitCommands();
   resetDisplay();
 
@@ -58,13 +316,19 @@ void OLEDDisplay::end() {
   #ifdef OLEDDISPLAY_DOUBLE_BUFFER
   if (this->buffer_back) free(this->buffer_back);
   #endif
+  if (this->background) free(this->background);
+  this->background = NULL;
+  this->backgroundSaved = false;
 }
 
 void OLEDDisplay::resetDisplay(void) {
   clear();
   #ifdef OLEDDISPLAY_DOUBLE_BUFFER
   memset(buffer_back, 1, DISPLAY_BUFFER_SIZE);
+  #elif defined(OLEDDISPLAY_BLOCK_HASH)
+  this->blockHashValid = false;
   #endif
+  markDirty();
   display();
 }
 
@@ -73,7 +337,8 @@ void OLEDDisplay::setColor(OLEDDISPLAY_COLOR color) {
 }
 
 void OLEDDisplay::setPixel(int16_t x, int16_t y) {
-  if (x >= 0 && x < 128 && y >= 0 && y < 64) {
+  if (x >= 0 && x < DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT) {
+    touch(y >> 3, x, x);
     switch (color) {
       case WHITE:   buffer[x + (y / 8) * DISPLAY_WIDTH] |=  (1 << (y & 7)); break;
       case BLACK:   buffer[x + (y / 8) * DISPLAY_WIDTH] &= ~(1 << (y & 7)); break;
@@ -130,8 +395,22 @@ void OLEDDisplay::drawRect(int16_t x, int16_t y, int16_t width, int16_t height)
 }
 
 void OLEDDisplay::fillRect(int16_t xMove, int16_t yMove, int16_t width, int16_t height) {
-  for (int16_t x = xMove; x < xMove + width; x++) {
-    drawVerticalLine(x, yMove, height);
+  int16_t x0 = _max(xMove, (int16_t) 0);
+  int16_t y0 = _max(yMove, (int16_t) 0);
+  int16_t x1 = _min((int16_t) (xMove + width), (int16_t) DISPLAY_WIDTH) - 1;
+  int16_t y1 = _min((int16_t) (yMove + height), (int16_t) DISPLAY_HEIGHT) - 1;
+  if (x0 > x1 || y0 > y1) return;
+
+  touchRect(x0, y0, x1, y1);
+
+  // One masked row per page, the first and last page may be partial
+  uint8_t firstPage = y0 >> 3;
+  uint8_t lastPage = y1 >> 3;
+  for (uint8_t page = firstPage; page <= lastPage; page++) {
+    uint8_t mask = 0xFF;
+    if (page == firstPage) mask &= 0xFF << (y0 & 7);
+    if (page == lastPage) mask &= 0xFF >> (7 - (y1 & 7));
+    maskRow(buffer + page * DISPLAY_WIDTH + x0, x1 - x0 + 1, mask, color);
   }
 }
 
@@ -235,23 +514,9 @@ void OLEDDisplay::drawHorizontalLine(int16_t x, int16_t y, int16_t length) {
 
   if (length <= 0) { return; }
 
-  uint8_t * bufferPtr = buffer;
-  bufferPtr += (y >> 3) * DISPLAY_WIDTH;
-  bufferPtr += x;
-
-  uint8_t drawBit = 1 << (y & 7);
+  touch(y >> 3, x, x + length - 1);
 
-  switch (color) {
-    case WHITE:   while (length--) {
-        *bufferPtr++ |= drawBit;
-      }; break;
-    case BLACK:   drawBit = ~drawBit;   while (length--) {
-        *bufferPtr++ &= drawBit;
-      }; break;
-    case INVERSE: while (length--) {
-        *bufferPtr++ ^= drawBit;
-      }; break;
-  }
+  maskRow(buffer + (y >> 3) * DISPLAY_WIDTH + x, length, 1 << (y & 7), color);
 }
 
 void OLEDDisplay::drawVerticalLine(int16_t x, int16_t y, int16_t length) {
@@ -268,6 +533,9 @@ void OLEDDisplay::drawVerticalLine(int16_t x, int16_t y, int16_t length) {
 
   if (length <= 0) return;
 
+  for (uint8_t page = y >> 3; page <= (y + length - 1) >> 3; page++) {
+    touch(page, x, x);
+  }
 
   uint8_t yOffset = y & 7;
   uint8_t drawBit;
@@ -352,28 +620,57 @@ void OLEDDisplay::drawFastImage(int16_t xMove, int16_t yMove, int16_t width, int
 }
 
 void OLEDDisplay::drawXbm(int16_t xMove, int16_t yMove, int16_t width, int16_t height, const char *xbm) {
-  int16_t widthInXbm = (width + 7) / 8;
-  uint8_t data;
-
-  for(int16_t y = 0; y < height; y++) {
-    for(int16_t x = 0; x < width; x++ ) {
-      if (x & 7) {
-        data >>= 1; // Move a bit
-      } else {  // Read new data every 8 bit
-        data = pgm_read_byte(xbm + (x / 8) + y * widthInXbm);
-      }
-      // if there is a bit draw it
-      if (data & 0x01) {
-        setPixel(xMove + x, yMove + y);
-      }
-    }
+  // Clip once, the bit loop itself never leaves the display
+  int16_t x0 = _max((int16_t) 0, (int16_t) -xMove);
+  int16_t y0 = _max((int16_t) 0, (int16_t) -yMove);
+  int16_t x1 = _min(width, (int16_t) (DISPLAY_WIDTH - xMove)) - 1;
+  int16_t y1 = _min(height, (int16_t) (DISPLAY_HEIGHT - yMove)) - 1;
+  if (x0 > x1 || y0 > y1) return;
+
+  touchRect(xMove + x0, yMove + y0, xMove + x1, yMove + y1);
+
+  XbmJob job;
+  job.xbm        = (const uint8_t *) xbm;
+  job.widthInXbm = (width + 7) / 8;
+  job.xMove      = xMove;
+  job.yMove      = yMove;
+  job.x0         = x0;
+  job.x1         = x1;
+  job.y0         = y0;
+  job.y1         = y1;
+
+  switch (this->color) {
+    case WHITE:   blitXbm<WHITE>(buffer, job); break;
+    case BLACK:   blitXbm<BLACK>(buffer, job); break;
+    case INVERSE: blitXbm<INVERSE>(buffer, job); break;
   }
 }
 
-void OLEDDisplay::drawStringInternal(int16_t xMove, int16_t yMove, char* text, uint16_t textLength, uint16_t textWidth) {
-  uint8_t textHeight       = pgm_read_byte(fontData + HEIGHT_POS);
-  uint8_t firstChar        = pgm_read_byte(fontData + FIRST_CHAR_POS);
-  uint16_t sizeOfJumpTable = pgm_read_byte(fontData + CHAR_NUM_POS)  * JUMPTABLE_BYTES;
+void OLEDDisplay::drawBuffer(int16_t xMove, int16_t yMove, const uint8_t *frame) {
+  if (xMove <= -DISPLAY_WIDTH || xMove >= DISPLAY_WIDTH) return;
+  if (yMove <= -DISPLAY_HEIGHT || yMove >= DISPLAY_HEIGHT) return;
+
+  int16_t x0 = _max((int16_t) 0, xMove);
+  int16_t x1 = _min((int16_t) (DISPLAY_WIDTH - 1), (int16_t) (DISPLAY_WIDTH - 1 + xMove));
+  touchRect(x0, yMove, x1, yMove + DISPLAY_HEIGHT - 1);
+
+  FrameJob job;
+  job.src     = frame + x0 - xMove;
+  job.dst     = buffer + x0;
+  job.columns = x1 - x0 + 1;
+  job.pages   = yMove >> 3; // floor, also for negative positions
+  job.shift   = yMove & 7;
+
+  switch (this->color) {
+    case WHITE:   blitFrame<WHITE>(job); break;
+    case BLACK:   blitFrame<BLACK>(job); break;
+    case INVERSE: blitFrame<INVERSE>(job); break;
+  }
+}
+
+void OLEDDisplay::drawStringInternal(int16_t xMove, int16_t yMove, const char* text, uint16_t textLength, uint16_t textWidth, uint8_t flags) {
+  loadGlyphs();
+  uint8_t textHeight       = this->glyphHeight;
 
   uint8_t cursorX         = 0;
   uint8_t cursorY         = 0;
@@ -394,38 +691,46 @@ void OLEDDisplay::drawStringInternal(int16_t xMove, int16_t yMove, char* text, u
   if (xMove + textWidth  < 0 || xMove > DISPLAY_WIDTH ) {return;}
   if (yMove + textHeight < 0 || yMove > DISPLAY_HEIGHT) {return;}
 
-  for (uint16_t j = 0; j < textLength; j++) {
+  TextReader reader(text, textLength, flags);
+  uint8_t code;
+  while (reader.next(code)) {
     int16_t xPos = xMove + cursorX;
     int16_t yPos = yMove + cursorY;
 
-    byte code = text[j];
-    if (code >= firstChar) {
-      byte charCode = code - firstChar;
-
-      // 4 Bytes per char code
-      byte msbJumpToChar    = pgm_read_byte( fontData + JUMPTABLE_START + charCode * JUMPTABLE_BYTES );                  // MSB  \ JumpAddress
-      byte lsbJumpToChar    = pgm_read_byte( fontData + JUMPTABLE_START + charCode * JUMPTABLE_BYTES + JUMPTABLE_LSB);   // LSB /
-      byte charByteSize     = pgm_read_byte( fontData + JUMPTABLE_START + charCode * JUMPTABLE_BYTES + JUMPTABLE_SIZE);  // Size
-      byte currentCharWidth = pgm_read_byte( fontData + JUMPTABLE_START + charCode * JUMPTABLE_BYTES + JUMPTABLE_WIDTH); // Width
-
+    OLEDDISPLAY_GLYPH charGlyph;
+    if (glyph(code, charGlyph)) {
       // Test if the char is drawable
-      if (!(msbJumpToChar == 255 && lsbJumpToChar == 255)) {
-        // Get the position of the char data
-        uint16_t charDataPosition = JUMPTABLE_START + sizeOfJumpTable + ((msbJumpToChar << 8) + lsbJumpToChar);
-        drawInternal(xPos, yPos, currentCharWidth, textHeight, fontData, charDataPosition, charByteSize);
+      if (charGlyph.offset) {
+        drawInternal(xPos, yPos, charGlyph.width, textHeight, fontData, charGlyph.offset, charGlyph.size);
       }
 
-      cursorX += currentCharWidth;
+      cursorX += charGlyph.width;
     }
   }
 }
 
 
-void OLEDDisplay::drawString(int16_t xMove, int16_t yMove, String strUser) {
-  uint16_t lineHeight = pgm_read_byte(fontData + HEIGHT_POS);
+void OLEDDisplay::drawString(int16_t xMove, int16_t yMove, const String &text) {
+  drawStringLines(xMove, yMove, text.c_str(), text.length(), OLEDDISPLAY_TEXT_UTF8);
+}
+
+void OLEDDisplay::drawString(int16_t xMove, int16_t yMove, const char *text) {
+  if (text == NULL) return;
+  drawStringLines(xMove, yMove, text, strlen(text), OLEDDISPLAY_TEXT_UTF8);
+}
+
+void OLEDDisplay::drawString(int16_t xMove, int16_t yMove, const char *text, uint16_t length) {
+  drawStringLines(xMove, yMove, text, length, OLEDDISPLAY_TEXT_UTF8);
+}
+
+void OLEDDisplay::drawString(int16_t xMove, int16_t yMove, const __FlashStringHelper *text) {
+  const char *flashText = (const char *) text;
+  drawStringLines(xMove, yMove, flashText, strlen_P(flashText), OLEDDISPLAY_TEXT_UTF8 | OLEDDISPLAY_TEXT_FLASH);
+}
 
-  // char* text must be freed!
-  char* text = utf8ascii(strUser);
+void OLEDDisplay::drawStringLines(int16_t xMove, int16_t yMove, const char* text, uint16_t length, uint8_t flags) {
+  loadGlyphs();
+  uint16_t lineHeight = this->glyphHeight;
 
   uint16_t yOffset = 0;
   // If the string should be centered vertically too
@@ -433,30 +738,48 @@ void OLEDDisplay::drawString(int16_t xMove, int16_t yMove, String strUser) {
   if (textAlignment == TEXT_ALIGN_CENTER_BOTH) {
     uint16_t lb = 0;
     // Find number of linebreaks in text
-    for (uint16_t i=0;text[i] != 0; i++) {
-      lb += (text[i] == 10);
+    for (uint16_t i = 0; i < length; i++) {
+      lb += (textByte(text, i, flags) == 10);
     }
     // Calculate center
     yOffset = (lb * lineHeight) / 2;
   }
 
+  // Every line on its own, lines without any char take no space
   uint16_t line = 0;
-  char* textPart = strtok(text,"\n");
-  while (textPart != NULL) {
-    uint16_t length = strlen(textPart);
-    drawStringInternal(xMove, yMove - yOffset + (line++) * lineHeight, textPart, length, getStringWidth(textPart, length));
-    textPart = strtok(NULL, "\n");
+  uint16_t lineStart = 0;
+  for (uint16_t i = 0; i <= length; i++) {
+    if (i < length && textByte(text, i, flags) != 10) continue;
+
+    uint16_t lineLength = i - lineStart;
+    TextReader probe(text + lineStart, lineLength, flags);
+    uint8_t code;
+    if (probe.next(code)) {
+      drawStringInternal(xMove, yMove - yOffset + (line++) * lineHeight, text + lineStart, lineLength,
+        getTextWidth(text + lineStart, lineLength, flags), flags);
+    }
+    lineStart = i + 1;
   }
-  free(text);
 }
 
-void OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, String strUser) {
-  uint16_t firstChar  = pgm_read_byte(fontData + FIRST_CHAR_POS);
-  uint16_t lineHeight = pgm_read_byte(fontData + HEIGHT_POS);
+void OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, const String &text) {
+  drawStringWrapped(xMove, yMove, maxLineWidth, text.c_str(), text.length(), OLEDDISPLAY_TEXT_UTF8);
+}
+
+void OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, const char *text) {
+  if (text == NULL) return;
+  drawStringWrapped(xMove, yMove, maxLineWidth, text, strlen(text), OLEDDISPLAY_TEXT_UTF8);
+}
+
+void OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, const __FlashStringHelper *text) {
+  const char *flashText = (const char *) text;
+  drawStringWrapped(xMove, yMove, maxLineWidth, flashText, strlen_P(flashText), OLEDDISPLAY_TEXT_UTF8 | OLEDDISPLAY_TEXT_FLASH);
+}
 
-  char* text = utf8ascii(strUser);
+void OLEDDisplay::drawStringWrapped(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, const char* text, uint16_t length, uint8_t flags) {
+  loadGlyphs();
+  uint16_t lineHeight = this->glyphHeight;
 
-  uint16_t length = strlen(text);
   uint16_t lastDrawnPos = 0;
   uint16_t lineNumber = 0;
   uint16_t strWidth = 0;
@@ -464,11 +787,20 @@ void OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxL
   uint16_t preferredBreakpoint = 0;
   uint16_t widthAtBreakpoint = 0;
 
-  for (uint16_t i = 0; i < length; i++) {
-    strWidth += pgm_read_byte(fontData + JUMPTABLE_START + (text[i] - firstChar) * JUMPTABLE_BYTES + JUMPTABLE_WIDTH);
+  // Positions are in bytes of the source text, a char ends at the
+  // position its last byte was read from
+  TextReader reader(text, length, flags);
+  uint8_t code;
+  while (reader.next(code)) {
+    uint16_t i = reader.position() - 1;
+
+    OLEDDISPLAY_GLYPH charGlyph;
+    if (glyph(code, charGlyph)) {
+      strWidth += charGlyph.width;
+    }
 
     // Always try to break on a space or dash
-    if (text[i] == ' ' || text[i]== '-') {
+    if (code == ' ' || code == '-') {
       preferredBreakpoint = i;
       widthAtBreakpoint = strWidth;
     }
@@ -478,7 +810,7 @@ void OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxL
         preferredBreakpoint = i;
         widthAtBreakpoint = strWidth;
       }
-      drawStringInternal(xMove, yMove + (lineNumber++) * lineHeight , &text[lastDrawnPos], preferredBreakpoint - lastDrawnPos, widthAtBreakpoint);
+      drawStringInternal(xMove, yMove + (lineNumber++) * lineHeight , text + lastDrawnPos, preferredBreakpoint - lastDrawnPos, widthAtBreakpoint, flags);
       lastDrawnPos = preferredBreakpoint + 1;
       // It is possible that we did not draw all letters to i so we need
       // to account for the width of the chars from `i - preferredBreakpoint`
@@ -490,21 +822,42 @@ void OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxL
 
   // Draw last part if needed
   if (lastDrawnPos < length) {
-    drawStringInternal(xMove, yMove + lineNumber * lineHeight , &text[lastDrawnPos], length - lastDrawnPos, getStringWidth(&text[lastDrawnPos], length - lastDrawnPos));
+    drawStringInternal(xMove, yMove + lineNumber * lineHeight , text + lastDrawnPos, length - lastDrawnPos, getTextWidth(text + lastDrawnPos, length - lastDrawnPos, flags), flags);
   }
+}
 
-  free(text);
+uint16_t OLEDDisplay::getStringWidth(const char* text, uint16_t length, bool utf8) {
+  return getTextWidth(text, length, utf8 ? OLEDDISPLAY_TEXT_UTF8 : 0);
 }
 
-uint16_t OLEDDisplay::getStringWidth(const char* text, uint16_t length) {
-  uint16_t firstChar        = pgm_read_byte(fontData + FIRST_CHAR_POS);
+uint16_t OLEDDisplay::getStringWidth(const char* text) {
+  if (text == NULL) return 0;
+  return getTextWidth(text, strlen(text), OLEDDISPLAY_TEXT_UTF8);
+}
+
+uint16_t OLEDDisplay::getStringWidth(const String &text) {
+  return getTextWidth(text.c_str(), text.length(), OLEDDISPLAY_TEXT_UTF8);
+}
+
+uint16_t OLEDDisplay::getStringWidth(const __FlashStringHelper *text) {
+  const char *flashText = (const char *) text;
+  return getTextWidth(flashText, strlen_P(flashText), OLEDDISPLAY_TEXT_UTF8 | OLEDDISPLAY_TEXT_FLASH);
+}
+
+uint16_t OLEDDisplay::getTextWidth(const char* text, uint16_t length, uint8_t flags) {
+  loadGlyphs();
 
   uint16_t stringWidth = 0;
   uint16_t maxWidth = 0;
 
-  while (length--) {
-    stringWidth += pgm_read_byte(fontData + JUMPTABLE_START + (text[length] - firstChar) * JUMPTABLE_BYTES + JUMPTABLE_WIDTH);
-    if (text[length] == 10) {
+  TextReader reader(text, length, flags);
+  uint8_t code;
+  while (reader.next(code)) {
+    OLEDDISPLAY_GLYPH charGlyph;
+    if (glyph(code, charGlyph)) {
+      stringWidth += charGlyph.width;
+    }
+    if (code == 10) {
       maxWidth = max(maxWidth, stringWidth);
       stringWidth = 0;
     }
@@ -513,12 +866,51 @@ uint16_t OLEDDisplay::getStringWidth(const char* text, uint16_t length) {
   return max(maxWidth, stringWidth);
 }
 
-uint16_t OLEDDisplay::getStringWidth(String strUser) {
-  char* text = utf8ascii(strUser);
-  uint16_t length = strlen(text);
-  uint16_t width = getStringWidth(text, length);
-  free(text);
-  return width;
+void OLEDDisplay::loadGlyphs() {
+  if (this->glyphFont == this->fontData) return;
+
+  this->glyphFont      = this->fontData;
+  this->glyphHeight    = pgm_read_byte(fontData + HEIGHT_POS);
+  this->glyphFirstChar = pgm_read_byte(fontData + FIRST_CHAR_POS);
+  this->glyphChars     = pgm_read_byte(fontData + CHAR_NUM_POS);
+
+#if OLEDDISPLAY_GLYPH_CACHE > 0
+  // Flash is only read 32 bits at a time, the cache spares four reads per char
+  this->glyphCached = 0;
+  uint8_t cached = _min(this->glyphChars, (uint8_t) OLEDDISPLAY_GLYPH_CACHE);
+  for (uint8_t charCode = 0; charCode < cached; charCode++) {
+    glyph(this->glyphFirstChar + charCode, this->glyphCache[charCode]);
+  }
+  this->glyphCached = cached;
+#endif
+}
+
+bool OLEDDisplay::glyph(uint8_t code, OLEDDISPLAY_GLYPH &glyph) {
+  if (code < this->glyphFirstChar) return false;
+  uint8_t charCode = code - this->glyphFirstChar;
+
+#if OLEDDISPLAY_GLYPH_CACHE > 0
+  if (charCode < this->glyphCached) {
+    glyph = this->glyphCache[charCode];
+    return true;
+  }
+#endif
+  if (charCode >= this->glyphChars) return false;
+
+  // 4 Bytes per char code
+  const char *entry = fontData + JUMPTABLE_START + charCode * JUMPTABLE_BYTES;
+  byte msbJumpToChar = pgm_read_byte(entry);                   // MSB  \ JumpAddress
+  byte lsbJumpToChar = pgm_read_byte(entry + JUMPTABLE_LSB);   // LSB /
+  glyph.size         = pgm_read_byte(entry + JUMPTABLE_SIZE);
+  glyph.width        = pgm_read_byte(entry + JUMPTABLE_WIDTH);
+
+  if (msbJumpToChar == 255 && lsbJumpToChar == 255) {
+    glyph.offset = 0;
+  } else {
+    // Get the position of the char data
+    glyph.offset = JUMPTABLE_START + this->glyphChars * JUMPTABLE_BYTES + ((msbJumpToChar << 8) + lsbJumpToChar);
+  }
+  return true;
 }
 
 void OLEDDisplay::setTextAlignment(OLEDDISPLAY_TEXT_ALIGNMENT textAlignment) {
@@ -556,7 +948,295 @@ void OLEDDisplay::flipScreenVertically() {
 }
 
 void OLEDDisplay::clear(void) {
-  memset(buffer, 0, DISPLAY_BUFFER_SIZE);
+  // After a full-screen frame one memset() beats a row per page
+  if (!this->backgroundSaved) {
+    uint8_t full = 0;
+    while (full < DISPLAY_PAGES && contentMinX[full] == 0 && contentMaxX[full] == DISPLAY_WIDTH - 1) full++;
+    if (full == DISPLAY_PAGES) {
+      memset(buffer, 0, DISPLAY_BUFFER_SIZE);
+      for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        contentMinX[page] = DISPLAY_WIDTH;
+        contentMaxX[page] = 0;
+        dirtyMinX[page] = 0;
+        dirtyMaxX[page] = DISPLAY_WIDTH - 1;
+      }
+      return;
+    }
+  }
+
+  // Only the columns drawn since the last clear can hold ink
+  for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+    uint8_t minX = contentMinX[page];
+    uint8_t maxX = contentMaxX[page];
+
+    if (this->backgroundSaved) {
+      // Outside what was drawn since, the buffer already matches the
+      // layer. An empty range is (DISPLAY_WIDTH, 0), so the union of two
+      // ranges is taken bound by bound.
+      uint8_t layerMinX = backgroundMinX[page];
+      uint8_t layerMaxX = backgroundMaxX[page];
+      if (layerMinX < minX) minX = layerMinX;
+      if (layerMaxX > maxX) maxX = layerMaxX;
+      if (minX > maxX) continue;
+
+      uint16_t offset = page * DISPLAY_WIDTH + minX;
+      memcpy(buffer + offset, background + offset, maxX - minX + 1);
+      contentMinX[page] = layerMinX;
+      contentMaxX[page] = layerMaxX;
+    } else {
+      if (minX > maxX) continue;
+
+      maskRow(buffer + page * DISPLAY_WIDTH + minX, maxX - minX + 1, 0xFF, BLACK);
+      contentMinX[page] = DISPLAY_WIDTH;
+      contentMaxX[page] = 0;
+    }
+    if (minX < dirtyMinX[page]) dirtyMinX[page] = minX;
+    if (maxX > dirtyMaxX[page]) dirtyMaxX[page] = maxX;
+  }
+}
+
+bool OLEDDisplay::saveBackground(void) {
+  if (!this->background) {
+    this->background = (uint8_t*) malloc(sizeof(uint8_t) * DISPLAY_BUFFER_SIZE);
+    if (!this->background) {
+      DEBUG_OLEDDISPLAY("[OLEDDISPLAY][saveBackground] Not enough memory to create background\n");
+      return false;
+    }
+  }
+
+  // Everything outside the content ranges is blank, the copy is only
+  // ever read back inside them
+  memcpy(this->background, this->buffer, DISPLAY_BUFFER_SIZE);
+  memcpy(this->backgroundMinX, this->contentMinX, DISPLAY_PAGES);
+  memcpy(this->backgroundMaxX, this->contentMaxX, DISPLAY_PAGES);
+  this->backgroundSaved = true;
+  return true;
+}
+
+void OLEDDisplay::dropBackground(void) {
+  // The layer ink is still part of the content ranges, the next clear()
+  // wipes it
+  this->backgroundSaved = false;
+}
+
+void OLEDDisplay::markDirty(int16_t x, int16_t y, int16_t width, int16_t height) {
+  if (width <= 0 || height <= 0) return;
+  touchRect(x, y, x + width - 1, y + height - 1);
+}
+
+void OLEDDisplay::markDirty(void) {
+  touchRect(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+}
+
+void OLEDDisplay::touchRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 >= DISPLAY_WIDTH) x1 = DISPLAY_WIDTH - 1;
+  if (y1 >= DISPLAY_HEIGHT) y1 = DISPLAY_HEIGHT - 1;
+  if (x0 > x1 || y0 > y1) return;
+
+  for (uint8_t page = y0 >> 3; page <= (y1 >> 3); page++) {
+    touch(page, x0, x1);
+  }
+}
+
+void OLEDDisplay::setScrollBand(uint8_t firstPage, uint8_t lastPage) {
+  this->scrollFirstPage = firstPage;
+  this->scrollLastPage = _min(lastPage, (uint8_t) (DISPLAY_PAGES - 1));
+  this->scrollPending = 0;
+}
+
+void OLEDDisplay::scrollBand(uint8_t columns) {
+  this->scrollPending = _min((uint16_t) (this->scrollPending + columns), (uint16_t) 0xFF);
+}
+
+uint8_t OLEDDisplay::takeScroll(uint8_t *commands) {
+  uint8_t columns = this->scrollPending;
+  this->scrollPending = 0;
+
+  #ifdef OLEDDISPLAY_DOUBLE_BUFFER
+  uint8_t first = this->scrollFirstPage;
+  uint8_t last = this->scrollLastPage;
+  if (columns != 1 || !this->contentScroll || first > last) return 0;
+
+  uint32_t now = millis();
+  if (now - this->scrollTime < OLEDDISPLAY_SCROLL_INTERVAL) return 0;
+  this->scrollTime = now;
+
+  // Same move on what the panel shows. The controller leaves the exposed
+  // column undefined for our purposes, it is sent again in any case. The
+  // whole row is compared, whatever did not move along is sent as well.
+  for (uint8_t page = first; page <= last; page++) {
+    uint8_t *row = buffer_back + page * DISPLAY_WIDTH;
+    memmove(row, row + 1, DISPLAY_WIDTH - 1);
+    row[DISPLAY_WIDTH - 1] = ~buffer[page * DISPLAY_WIDTH + DISPLAY_WIDTH - 1];
+    dirtyMinX[page] = 0;
+    dirtyMaxX[page] = DISPLAY_WIDTH - 1;
+  }
+
+  commands[0] = CONTENTSCROLLLEFT;
+  commands[1] = 0x00;
+  commands[2] = first;
+  commands[3] = 0x01;
+  commands[4] = last;
+  commands[5] = 0x00;
+  commands[6] = DISPLAY_WIDTH - 1;
+  return OLEDDISPLAY_SCROLL_COMMANDS;
+  #else
+  (void) columns;
+  (void) commands;
+  return 0;
+  #endif
+}
+
+uint8_t OLEDDisplay::planFlush() {
+  // Changed spans per page. A run of unchanged bytes only splits a span if
+  // skipping it is cheaper than addressing another window.
+  OLEDDISPLAY_WINDOW spans[DISPLAY_PAGES][OLEDDISPLAY_PAGE_SPANS];
+  uint8_t spanCount[DISPLAY_PAGES];
+  uint8_t changedPages[DISPLAY_PAGES];
+  uint8_t changed = 0;
+  uint16_t splitGap = windowCost + pageCost;
+
+  for (uint8_t y = 0; y < DISPLAY_PAGES; y++) {
+    spanCount[y] = 0;
+    uint8_t minX = dirtyMinX[y];
+    uint8_t maxX = dirtyMaxX[y];
+    if (minX > maxX) continue;
+    dirtyMinX[y] = DISPLAY_WIDTH;
+    dirtyMaxX[y] = 0;
+
+    OLEDDISPLAY_WINDOW *span = spans[y];
+    #ifdef OLEDDISPLAY_DOUBLE_BUFFER
+    uint8_t *front = buffer + y * DISPLAY_WIDTH;
+    uint8_t *back = buffer_back + y * DISPLAY_WIDTH;
+    uint8_t count = 0;
+    uint16_t gap = 0;
+    for (uint16_t x = minX; x <= maxX; x++) {
+      // Whole equal words are skipped at once
+      if (!(x & 3) && x + 3 <= maxX && *(const bufferWord *) (front + x) == *(const bufferWord *) (back + x)) {
+        gap += 4;
+        x += 3;
+        continue;
+      }
+      if (front[x] == back[x]) {
+        gap++;
+        continue;
+      }
+      back[x] = front[x];
+      if (count && (gap <= splitGap || count == OLEDDISPLAY_PAGE_SPANS)) {
+        span[count - 1].maxX = x;
+      } else {
+        span[count].minX = span[count].maxX = x;
+        count++;
+      }
+      gap = 0;
+    }
+    if (!count) continue;
+    #elif defined(OLEDDISPLAY_BLOCK_HASH)
+    // Only the dirty part of a changed block is sent, the rest of it has
+    // not been written since the last flush
+    const uint8_t *front = buffer + y * DISPLAY_WIDTH;
+    uint16_t *hash = blockHash[y];
+    uint8_t count = 0;
+    for (uint8_t b = minX / OLEDDISPLAY_BLOCK_WIDTH; b <= maxX / OLEDDISPLAY_BLOCK_WIDTH; b++) {
+      uint8_t x0 = b * OLEDDISPLAY_BLOCK_WIDTH;
+      uint16_t crc = blockCrc(front + x0);
+      if (crc == hash[b] && this->blockHashValid) continue;
+      hash[b] = crc;
+
+      uint8_t x1 = _min((uint8_t) (x0 + OLEDDISPLAY_BLOCK_WIDTH - 1), maxX);
+      x0 = _max(x0, minX);
+      if (count && (x0 - span[count - 1].maxX - 1 <= splitGap || count == OLEDDISPLAY_PAGE_SPANS)) {
+        span[count - 1].maxX = x1;
+      } else {
+        span[count].minX = x0;
+        span[count].maxX = x1;
+        count++;
+      }
+    }
+    if (!count) continue;
+    #else
+    span[0].minX = minX;
+    span[0].maxX = maxX;
+    uint8_t count = 1;
+    #endif
+
+    for (uint8_t i = 0; i < count; i++) {
+      span[i].minPage = span[i].maxPage = y;
+    }
+    spanCount[y] = count;
+    changedPages[changed++] = y;
+  }
+
+  #ifdef OLEDDISPLAY_BLOCK_HASH
+  // resetDisplay() marks the whole display, every hash is fresh now
+  this->blockHashValid = true;
+  #endif
+
+  if (!changed) return 0;
+
+  // Cover the changed pages with windows at the lowest cost. best[k] is
+  // the cheapest plan for the first k changed pages, start[k] the first
+  // changed page of its last window. A window over several pages spans the
+  // union of their columns, including unchanged pages in between. A window
+  // starting and ending on the same page uses that page's own spans.
+  uint16_t best[DISPLAY_PAGES + 1];
+  uint8_t start[DISPLAY_PAGES + 1];
+  best[0] = 0;
+  for (uint8_t k = 1; k <= changed; k++) {
+    uint8_t last = changedPages[k - 1];
+
+    uint16_t single = 0;
+    for (uint8_t i = 0; i < spanCount[last]; i++) {
+      single += windowCost + pageCost + spans[last][i].maxX - spans[last][i].minX + 1;
+    }
+    best[k] = best[k - 1] + single;
+    start[k] = k - 1;
+
+    uint8_t minX = spans[last][0].minX;
+    uint8_t maxX = spans[last][spanCount[last] - 1].maxX;
+    for (int8_t i = k - 2; i >= 0; i--) {
+      uint8_t first = changedPages[i];
+      minX = _min(minX, spans[first][0].minX);
+      maxX = _max(maxX, spans[first][spanCount[first] - 1].maxX);
+      uint16_t cost = best[i] + windowCost + (last - first + 1) * (pageCost + maxX - minX + 1);
+      if (cost < best[k]) {
+        best[k] = cost;
+        start[k] = i;
+      }
+    }
+  }
+
+  // Walk the plan backwards, the windows end up sorted by page
+  uint8_t windows = 0;
+  for (uint8_t k = changed; k > 0; k = start[k]) {
+    windows += start[k] == k - 1 ? spanCount[changedPages[k - 1]] : 1;
+  }
+
+  uint8_t n = windows;
+  for (uint8_t k = changed; k > 0; k = start[k]) {
+    uint8_t first = changedPages[start[k]];
+    uint8_t last = changedPages[k - 1];
+    if (start[k] == k - 1) {
+      for (int8_t i = spanCount[last] - 1; i >= 0; i--) {
+        flushWindows[--n] = spans[last][i];
+      }
+    } else {
+      OLEDDISPLAY_WINDOW &window = flushWindows[--n];
+      window.minPage = first;
+      window.maxPage = last;
+      window.minX = DISPLAY_WIDTH - 1;
+      window.maxX = 0;
+      for (uint8_t i = start[k]; i < k; i++) {
+        uint8_t page = changedPages[i];
+        window.minX = _min(window.minX, spans[page][0].minX);
+        window.maxX = _max(window.maxX, spans[page][spanCount[page] - 1].maxX);
+      }
+    }
+  }
+
+  return windows;
 }
 
 void OLEDDisplay::drawLogBuffer(uint16_t xMove, uint16_t yMove) {
@@ -575,7 +1255,7 @@ void OLEDDisplay::drawLogBuffer(uint16_t xMove, uint16_t yMove) {
       length++;
       // Draw string on line `line` from lastPos to length
       // Passing 0 as the lenght because we are in TEXT_ALIGN_LEFT
-      drawStringInternal(xMove, yMove + (line++) * lineHeight, &this->logBuffer[lastPos], length, 0);
+      drawStringInternal(xMove, yMove + (line++) * lineHeight, &this->logBuffer[lastPos], length, 0, 0);
       // Remember last pos
       lastPos = i;
       // Reset length
@@ -587,7 +1267,7 @@ void OLEDDisplay::drawLogBuffer(uint16_t xMove, uint16_t yMove) {
   }
   // Draw the remaining string
   if (length > 0) {
-    drawStringInternal(xMove, yMove + line * lineHeight, &this->logBuffer[lastPos], length, 0);
+    drawStringInternal(xMove, yMove + line * lineHeight, &this->logBuffer[lastPos], length, 0, 0);
   }
 }
 
@@ -670,7 +1350,7 @@ void OLEDDisplay::sendInitCommands(void) {
   sendCommand(SETDISPLAYCLOCKDIV);
   sendCommand(0xF0); // Increase speed of the display max ~96Hz
   sendCommand(SETMULTIPLEX);
-  sendCommand(0x3F);
+  sendCommand(DISPLAY_HEIGHT - 1);
   sendCommand(SETDISPLAYOFFSET);
   sendCommand(0x00);
   sendCommand(SETSTARTLINE);
@@ -681,7 +1361,7 @@ void OLEDDisplay::sendInitCommands(void) {
   sendCommand(SEGREMAP);
   sendCommand(COMSCANINC);
   sendCommand(SETCOMPINS);
-  sendCommand(0x12);
+  sendCommand(DISPLAY_COMPINS);
   sendCommand(SETCONTRAST);
   sendCommand(0xCF);
   sendCommand(SETPRECHARGE);
@@ -693,69 +1373,43 @@ void OLEDDisplay::sendInitCommands(void) {
 }
 
 void inline OLEDDisplay::drawInternal(int16_t xMove, int16_t yMove, int16_t width, int16_t height, const char *data, uint16_t offset, uint16_t bytesInData) {
-  if (width < 0 || height < 0) return;
+  if (width <= 0 || height <= 0) return;
   if (yMove + height < 0 || yMove > DISPLAY_HEIGHT)  return;
   if (xMove + width  < 0 || xMove > DISPLAY_WIDTH)   return;
 
   uint8_t  rasterHeight = 1 + ((height - 1) >> 3); // fast ceil(height / 8.0)
-  int8_t   yOffset      = yMove & 7;
 
-  bytesInData = bytesInData == 0 ? width * rasterHeight : bytesInData;
+  // Padding bits of the last raster row may be set too
+  touchRect(xMove, yMove, xMove + width - 1, yMove + (rasterHeight << 3) - 1);
 
-  int16_t initYMove   = yMove;
-  int8_t  initYOffset = yOffset;
-
-
-  for (uint16_t i = 0; i < bytesInData; i++) {
+  bytesInData = bytesInData == 0 ? width * rasterHeight : bytesInData;
 
-    // Reset if next horizontal drawing phase is started.
-    if ( i % rasterHeight == 0) {
-      yMove   = initYMove;
-      yOffset = initYOffset;
+  // Clip the columns once, fonts leave out trailing empty bytes
+  int16_t firstColumn = xMove < 0 ? -xMove : 0;
+  int16_t lastColumn  = _min((int16_t) (width - 1), (int16_t) (DISPLAY_WIDTH - 1 - xMove));
+  lastColumn = _min(lastColumn, (int16_t) ((bytesInData - 1) / rasterHeight));
+  if (firstColumn > lastColumn) return;
+
+  BlitJob job;
+  job.dst          = buffer + xMove + firstColumn;
+  job.src          = (const uint8_t *) data + offset + firstColumn * rasterHeight;
+  job.columns      = lastColumn - firstColumn + 1;
+  job.rasterHeight = rasterHeight;
+  job.lastRows     = _min((uint16_t) rasterHeight, (uint16_t) (bytesInData - lastColumn * rasterHeight));
+  job.page         = yMove >> 3; // floor, also for negative positions
+  job.shift        = yMove & 7;
+
+  if (job.shift) {
+    switch (this->color) {
+      case WHITE:   blit<WHITE, false>(job); break;
+      case BLACK:   blit<BLACK, false>(job); break;
+      case INVERSE: blit<INVERSE, false>(job); break;
     }
-
-    byte currentByte = pgm_read_byte(data + offset + i);
-
-    int16_t xPos = xMove + (i / rasterHeight);
-    int16_t yPos = ((yMove >> 3) + (i % rasterHeight)) * DISPLAY_WIDTH;
-
-    int16_t yScreenPos = yMove + yOffset;
-    int16_t dataPos    = xPos  + yPos;
-
-    if (dataPos >=  0  && dataPos < DISPLAY_BUFFER_SIZE &&
-        xPos    >=  0  && xPos    < DISPLAY_WIDTH ) {
-
-      if (yOffset >= 0) {
-        switch (this->color) {
-          case WHITE:   buffer[dataPos] |= currentByte << yOffset; break;
-          case BLACK:   buffer[dataPos] &= ~(currentByte << yOffset); break;
-          case INVERSE: buffer[dataPos] ^= currentByte << yOffset; break;
-        }
-        if (dataPos < (DISPLAY_BUFFER_SIZE - DISPLAY_WIDTH)) {
-          switch (this->color) {
-            case WHITE:   buffer[dataPos + DISPLAY_WIDTH] |= currentByte >> (8 - yOffset); break;
-            case BLACK:   buffer[dataPos + DISPLAY_WIDTH] &= ~(currentByte >> (8 - yOffset)); break;
-            case INVERSE: buffer[dataPos + DISPLAY_WIDTH] ^= currentByte >> (8 - yOffset); break;
-          }
-        }
-      } else {
-        // Make new offset position
-        yOffset = -yOffset;
-
-        switch (this->color) {
-          case WHITE:   buffer[dataPos] |= currentByte >> yOffset; break;
-          case BLACK:   buffer[dataPos] &= ~(currentByte >> yOffset); break;
-          case INVERSE: buffer[dataPos] ^= currentByte >> yOffset; break;
-        }
-
-        // Prepare for next iteration by moving one block up
-        yMove -= 8;
-
-        // and setting the new yOffset
-        yOffset = 8 - yOffset;
-      }
-
-      yield();
+  } else {
+    switch (this->color) {
+      case WHITE:   blit<WHITE, true>(job); break;
+      case BLACK:   blit<BLACK, true>(job); break;
+      case INVERSE: blit<INVERSE, true>(job); break;
     }
   }
 }
@@ -763,48 +1417,5 @@ void inline OLEDDisplay::drawInternal(int16_t xMove, int16_t yMove, int16_t widt
 // Code form http://playground.arduino.cc/Main/Utf8ascii
 uint8_t OLEDDisplay::utf8ascii(byte ascii) {
   static uint8_t LASTCHAR;
-
-  if ( ascii < 128 ) { // Standard ASCII-set 0..0x7F handling
-    LASTCHAR = 0;
-    return ascii;
-  }
-
-  uint8_t last = LASTCHAR;   // get last char
-  LASTCHAR = ascii;
-
-  switch (last) {    // conversion depnding on first UTF8-character
-    case 0xC2: return  (ascii);  break;
-    case 0xC3: return  (ascii | 0xC0);  break;
-    case 0x82: if (ascii == 0xAC) return (0x80);    // special case Euro-symbol
-  }
-
-  return  0; // otherwise: return zero, if character has to be ignored
-}
-
-// You need to free the char!
-char* OLEDDisplay::utf8ascii(String str) {
-  uint16_t k = 0;
-  uint16_t length = str.length() + 1;
-
-  // Copy the string into a char array
-  char* s = (char*) malloc(length * sizeof(char));
-  if(!s) {
-    DEBUG_OLEDDISPLAY("[OLEDDISPLAY][utf8ascii] Can't allocate another char array. Drop support for UTF-8.\n");
-    return (char*) str.c_str();
-  }
-  str.toCharArray(s, length);
-
-  length--;
-
-  for (uint16_t i=0; i < length; i++) {
-    char c = utf8ascii(s[i]);
-    if (c!=0) {
-      s[k++]=c;
-    }
-  }
-
-  s[k]=0;
-
-  // This will leak 's' be sure to free it in the calling function.
-  return s;
+  return decodeUtf8(ascii, LASTCHAR);
 }
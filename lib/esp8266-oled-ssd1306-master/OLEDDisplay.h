@@ -37,16 +37,45 @@
 #define DEBUG_OLEDDISPLAY(...)
 #endif
 
-// Use DOUBLE BUFFERING by default
-#ifndef OLEDDISPLAY_REDUCE_MEMORY
+// Use DOUBLE BUFFERING by default. OLEDDISPLAY_BLOCK_HASH replaces the back
+// buffer with a CRC per block of columns, OLEDDISPLAY_REDUCE_MEMORY drops
+// change detection altogether.
+#if !defined(OLEDDISPLAY_REDUCE_MEMORY) && !defined(OLEDDISPLAY_BLOCK_HASH)
 #define OLEDDISPLAY_DOUBLE_BUFFER
 #endif
 
 
-// Display settings
+// Display settings, override the geometry for smaller panels, e.g.
+// -D DISPLAY_HEIGHT=32 for a 128x32 SSD1306. Buffers, flush planning and
+// the init sequence follow it.
+#ifndef DISPLAY_WIDTH
 #define DISPLAY_WIDTH 128
+#endif
+#ifndef DISPLAY_HEIGHT
 #define DISPLAY_HEIGHT 64
-#define DISPLAY_BUFFER_SIZE 1024
+#endif
+#define DISPLAY_BUFFER_SIZE (DISPLAY_WIDTH * DISPLAY_HEIGHT / 8)
+#define DISPLAY_PAGES (DISPLAY_HEIGHT / 8)
+
+// COM pin configuration: alternative for 64 rows, sequential for 32 or
+// fewer rows as wired on the usual 128x32 modules
+#ifndef DISPLAY_COMPINS
+#define DISPLAY_COMPINS (DISPLAY_HEIGHT > 32 ? 0x12 : 0x02)
+#endif
+
+// Flush planning: changed spans tracked per page, and the windows a
+// flush may be split into
+#ifndef OLEDDISPLAY_PAGE_SPANS
+#define OLEDDISPLAY_PAGE_SPANS 3
+#endif
+#define OLEDDISPLAY_MAX_WINDOWS (DISPLAY_PAGES * OLEDDISPLAY_PAGE_SPANS)
+
+// Columns per hashed block with OLEDDISPLAY_BLOCK_HASH, two bytes of RAM
+// per block and page
+#ifndef OLEDDISPLAY_BLOCK_WIDTH
+#define OLEDDISPLAY_BLOCK_WIDTH 16
+#endif
+#define OLEDDISPLAY_BLOCKS (DISPLAY_WIDTH / OLEDDISPLAY_BLOCK_WIDTH)
 
 // Header Values
 #define JUMPTABLE_BYTES 4
@@ -61,12 +90,32 @@
 #define FIRST_CHAR_POS 2
 #define CHAR_NUM_POS 3
 
+// Jump table entries of the current font kept in RAM, counted from its
+// first char, 4 bytes each. 96 (384 bytes) covers printable ASCII in the
+// bundled fonts, chars past the cache are read from flash. 0 disables it.
+#ifndef OLEDDISPLAY_GLYPH_CACHE
+#define OLEDDISPLAY_GLYPH_CACHE 96
+#endif
+
+// Text handed to the internal renderer: in flash instead of RAM, and
+// UTF-8 instead of the extended ASCII of the fonts
+#define OLEDDISPLAY_TEXT_FLASH 0x01
+#define OLEDDISPLAY_TEXT_UTF8  0x02
+
+// Hardware scrolling: the controller needs two panel frames between two
+// scroll steps, at the ~96 Hz set up by sendInitCommands() that is 21 ms
+#ifndef OLEDDISPLAY_SCROLL_INTERVAL
+#define OLEDDISPLAY_SCROLL_INTERVAL 25
+#endif
+#define OLEDDISPLAY_SCROLL_COMMANDS 7
+
 
 // Display commands
 #define CHARGEPUMP 0x8D
 #define COLUMNADDR 0x21
 #define COMSCANDEC 0xC8
 #define COMSCANINC 0xC0
+#define CONTENTSCROLLLEFT 0x2D
 #define DISPLAYALLON 0xA5
 #define DISPLAYALLON_RESUME 0xA4
 #define DISPLAYOFF 0xAE
@@ -100,6 +149,21 @@ enum OLEDDISPLAY_COLOR {
   INVERSE = 2
 };
 
+// Rectangle of the display RAM written in one go, in columns and pages
+struct OLEDDISPLAY_WINDOW {
+  uint8_t minX;
+  uint8_t maxX;
+  uint8_t minPage;
+  uint8_t maxPage;
+};
+
+// Jump table entry of a char, resolved to the position of its data
+struct OLEDDISPLAY_GLYPH {
+  uint16_t offset;   // from the start of the font, 0 if there is nothing to draw
+  uint8_t  size;
+  uint8_t  width;
+};
+
 enum OLEDDISPLAY_TEXT_ALIGNMENT {
   TEXT_ALIGN_LEFT = 0,
   TEXT_ALIGN_RIGHT = 1,
@@ -160,22 +224,35 @@ class OLEDDisplay : public Print {
     // Draw a XBM
     void drawXbm(int16_t x, int16_t y, int16_t width, int16_t height, const char *xbm);
 
+    // Draw a whole frame laid out like `buffer`, moved by x, y. Its set
+    // pixels are drawn in the current color.
+    void drawBuffer(int16_t x, int16_t y, const uint8_t *frame);
+
     /* Text functions */
 
-    // Draws a string at the given location
-    void drawString(int16_t x, int16_t y, String text);
+    // Draws a string at the given location. Text is UTF-8 and decoded
+    // while drawing, none of the text functions allocate memory.
+    void drawString(int16_t x, int16_t y, const String &text);
+    void drawString(int16_t x, int16_t y, const char *text);
+    void drawString(int16_t x, int16_t y, const char *text, uint16_t length);
+    void drawString(int16_t x, int16_t y, const __FlashStringHelper *text);
 
     // Draws a String with a maximum width at the given location.
     // If the given String is wider than the specified width
     // The text will be wrapped to the next line at a space or dash
-    void drawStringMaxWidth(int16_t x, int16_t y, uint16_t maxLineWidth, String text);
+    void drawStringMaxWidth(int16_t x, int16_t y, uint16_t maxLineWidth, const String &text);
+    void drawStringMaxWidth(int16_t x, int16_t y, uint16_t maxLineWidth, const char *text);
+    void drawStringMaxWidth(int16_t x, int16_t y, uint16_t maxLineWidth, const __FlashStringHelper *text);
 
     // Returns the width of the const char* with the current
-    // font settings
-    uint16_t getStringWidth(const char* text, uint16_t length);
+    // font settings. The bytes are taken as they are, already in the
+    // font's extended ASCII; pass utf8 for text as drawString() takes it.
+    uint16_t getStringWidth(const char* text, uint16_t length, bool utf8 = false);
 
-    // Convencience method for the const char version
-    uint16_t getStringWidth(String text);
+    // Convencience methods for the const char version, these decode UTF-8
+    uint16_t getStringWidth(const char* text);
+    uint16_t getStringWidth(const String &text);
+    uint16_t getStringWidth(const __FlashStringHelper *text);
 
     // Specifies relative to which anchor point
     // the text is rendered. Available constants:
@@ -209,9 +286,49 @@ class OLEDDisplay : public Print {
     // Write the buffer to the display memory
     virtual void display(void) = 0;
 
-    // Clear the local pixel buffer
+    // Drivers with asynchronous flushing send the next page of the flush
+    // started by display(). Returns true while there is more to send.
+    virtual bool pump(void) { return false; }
+
+    // True while a flush is being sent or waits to be
+    virtual bool flushInProgress() const { return false; }
+
+    // Block until a pending asynchronous flush is on the display
+    void waitForFlush(void) { while (pump()) yield(); }
+
+    // Clear the local pixel buffer, back to the background layer if one
+    // is saved
     void clear(void);
 
+    // Background layer. saveBackground() keeps a copy of the buffer as it
+    // is now, from then on clear() restores that copy instead of wiping
+    // the buffer, only over the columns drawn since. Returns false if the
+    // copy could not be allocated.
+    bool saveBackground(void);
+
+    // Let clear() wipe the buffer again. The copy stays allocated for the
+    // next saveBackground().
+    void dropBackground(void);
+
+    bool hasBackground(void) { return this->backgroundSaved; }
+
+    // Mark a region as changed so the next display() sends it. Only needed
+    // after writing to `buffer` directly, the drawing functions keep track
+    // of what they touch.
+    void markDirty(int16_t x, int16_t y, int16_t width, int16_t height);
+    void markDirty(void);
+
+    // Hardware scrolling of the pages firstPage..lastPage on controllers
+    // with content scroll (SSD1306). Call scrollBand() after the content
+    // drawn into the band moved one column to the left: the next display()
+    // lets the controller shift the panel RAM and only sends the exposed
+    // column and whatever else changed. Larger moves, or moves closer than
+    // OLEDDISPLAY_SCROLL_INTERVAL, are sent the normal way. Needs
+    // OLEDDISPLAY_DOUBLE_BUFFER to know what the panel shows; the back
+    // buffer follows every step, so a needless call only costs bytes.
+    void setScrollBand(uint8_t firstPage, uint8_t lastPage);
+    void scrollBand(uint8_t columns = 1);
+
     // Log buffer implementation
 
     // This will define the lines and characters you can
@@ -226,6 +343,8 @@ class OLEDDisplay : public Print {
     size_t write(uint8_t c);
     size_t write(const char* s);
 
+    // Both buffers come from malloc() and are word aligned, the
+    // framebuffer kernels process them 32 bits at a time
     uint8_t            *buffer;
 
     #ifdef OLEDDISPLAY_DOUBLE_BUFFER
@@ -234,11 +353,27 @@ class OLEDDisplay : public Print {
 
   protected:
 
+    // Copy restored by clear(), and the columns per page it has ink in
+    uint8_t            *background            = NULL;
+    bool                backgroundSaved       = false;
+    uint8_t             backgroundMinX[DISPLAY_PAGES];
+    uint8_t             backgroundMaxX[DISPLAY_PAGES];
+
     OLEDDISPLAY_TEXT_ALIGNMENT   textAlignment = TEXT_ALIGN_LEFT;
     OLEDDISPLAY_COLOR            color         = WHITE;
 
     const char          *fontData              = ArialMT_Plain_10;
 
+    // Font the glyph cache was loaded for
+    const char          *glyphFont             = NULL;
+    uint8_t              glyphHeight           = 0;
+    uint8_t              glyphFirstChar        = 0;
+    uint8_t              glyphChars            = 0;
+    uint8_t              glyphCached           = 0;
+#if OLEDDISPLAY_GLYPH_CACHE > 0
+    OLEDDISPLAY_GLYPH    glyphCache[OLEDDISPLAY_GLYPH_CACHE];
+#endif
+
     // State values for logBuffer
     uint16_t   logBufferSize                   = 0;
     uint16_t   logBufferFilled                 = 0;
@@ -246,6 +381,65 @@ class OLEDDisplay : public Print {
     uint16_t   logBufferMaxLines               = 0;
     char      *logBuffer                       = NULL;
 
+    // Column ranges per page written since the last display(), and since
+    // the last clear(). A range is empty while min > max.
+    uint8_t    dirtyMinX[DISPLAY_PAGES];
+    uint8_t    dirtyMaxX[DISPLAY_PAGES];
+    uint8_t    contentMinX[DISPLAY_PAGES];
+    uint8_t    contentMaxX[DISPLAY_PAGES];
+
+    #ifdef OLEDDISPLAY_BLOCK_HASH
+    // CRC of every block as of the last flush, stale while !blockHashValid
+    uint16_t   blockHash[DISPLAY_PAGES][OLEDDISPLAY_BLOCKS];
+    bool       blockHashValid                  = false;
+    #endif
+
+    // Record that columns x0..x1 of a page were written, coordinates are
+    // already clipped to the display
+    inline void touch(uint8_t page, uint8_t x0, uint8_t x1) __attribute__((always_inline)) {
+      if (x0 < dirtyMinX[page]) dirtyMinX[page] = x0;
+      if (x1 > dirtyMaxX[page]) dirtyMaxX[page] = x1;
+      if (x0 < contentMinX[page]) contentMinX[page] = x0;
+      if (x1 > contentMaxX[page]) contentMaxX[page] = x1;
+    }
+    void touchRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+    // Bus cost of addressing a window and of addressing every page inside
+    // it, in data byte times. Drivers set these for their protocol, the
+    // flush planner trades them against sending unchanged bytes.
+    uint8_t    windowCost                      = 24;
+    uint8_t    pageCost                        = 0;
+
+    // Set by drivers whose controller has content scroll
+    bool       contentScroll                   = false;
+
+    // Scroll band, empty while first > last, and columns it moved since
+    // the last flush
+    uint8_t    scrollFirstPage                 = 1;
+    uint8_t    scrollLastPage                  = 0;
+    uint8_t    scrollPending                   = 0;
+    uint32_t   scrollTime                      = 0;
+
+    // Take the pending scroll of the flush about to be planned. If the
+    // panel is to scroll, buffer_back is shifted to match and its exposed
+    // column forced to differ, and the command bytes are written to
+    // `commands` (OLEDDISPLAY_SCROLL_COMMANDS). Returns their number, 0 if
+    // nothing scrolls. Call before planFlush().
+    uint8_t takeScroll(uint8_t *commands);
+
+    // Windows planned by the last planFlush()
+    OLEDDISPLAY_WINDOW flushWindows[OLEDDISPLAY_MAX_WINDOWS];
+
+    // Plan the windows for sending what changed since the last flush and
+    // reset the dirty state. With double buffering only the dirty ranges
+    // are compared against buffer_back and copied over. With
+    // OLEDDISPLAY_BLOCK_HASH the blocks they overlap are hashed and only
+    // those whose CRC changed are sent, so a collision (1 in 65536) leaves
+    // a block stale until it changes again. Otherwise the dirty ranges
+    // themselves are sent. Returns the number of windows in flushWindows,
+    // 0 when there is nothing to send.
+    uint8_t planFlush();
+
     // Send a command to the display (low level function)
     virtual void sendCommand(uint8_t com) {};
 
@@ -256,12 +450,23 @@ class OLEDDisplay : public Print {
     void sendInitCommands();
 
     // converts utf8 characters to extended ascii
-    static char* utf8ascii(String s);
     static byte utf8ascii(byte ascii);
 
     void inline drawInternal(int16_t xMove, int16_t yMove, int16_t width, int16_t height, const char *data, uint16_t offset, uint16_t bytesInData) __attribute__((always_inline));
 
-    void drawStringInternal(int16_t xMove, int16_t yMove, char* text, uint16_t textLength, uint16_t textWidth);
+    // The text functions for any source, `flags` are OLEDDISPLAY_TEXT_*
+    void drawStringLines(int16_t xMove, int16_t yMove, const char* text, uint16_t length, uint8_t flags);
+    void drawStringWrapped(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, const char* text, uint16_t length, uint8_t flags);
+    uint16_t getTextWidth(const char* text, uint16_t length, uint8_t flags);
+
+    void drawStringInternal(int16_t xMove, int16_t yMove, const char* text, uint16_t textLength, uint16_t textWidth, uint8_t flags);
+
+    // Load the jump table of fontData into the glyph cache if it holds
+    // another font
+    void loadGlyphs();
+
+    // Look up a char of the current font, false if the font lacks it
+    bool glyph(uint8_t code, OLEDDISPLAY_GLYPH &glyph);
 
 };
 
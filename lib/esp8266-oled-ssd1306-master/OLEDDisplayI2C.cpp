@@ -0,0 +1,181 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 by Daniel Eichhorn
+ * Copyright (c) 2016 by Fabrice Weinberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "OLEDDisplayI2C.h"
+
+OLEDDisplayI2C::OLEDDisplayI2C(uint8_t address, OLEDI2CBus &bus) : bus(bus) {
+  this->_address = address;
+  // Six packed commands in their own transaction, then a new data transaction
+  this->windowCost = 12;
+  this->resetBusStats();
+}
+
+bool OLEDDisplayI2C::connect() {
+  if (!this->bus.begin()) return false;
+  this->transferLimit = _min(this->bus.maxTransfer(), (uint16_t) OLEDDISPLAY_I2C_BUFFER);
+  this->transferLength = 0;
+  this->holdCommands = true;
+  return true;
+}
+
+void OLEDDisplayI2C::sendCommand(uint8_t com) {
+  this->queue(OLEDDISPLAY_I2C_COMMANDS, &com, 1);
+  if (!this->holdCommands) this->flushTransfer();
+}
+
+void OLEDDisplayI2C::display(void) {
+  if (this->flushing) {
+    // Still on the bus, the dirty state keeps collecting until it is done
+    this->framePending = true;
+    return;
+  }
+
+  this->startFlush();
+  if (!this->async) waitForFlush();
+}
+
+bool OLEDDisplayI2C::pump(void) {
+  if (!this->flushing) {
+    if (!this->framePending) return false;
+    this->framePending = false;
+    this->startFlush();
+  }
+
+  uint32_t start = micros();
+  bool more = this->flushing && this->sendPage();
+  this->flushMicros += micros() - start;
+  if (!more) this->finishFlush();
+
+  return this->flushing || this->framePending;
+}
+
+void OLEDDisplayI2C::setAsyncFlush(bool enabled) {
+  #ifdef OLEDDISPLAY_DOUBLE_BUFFER
+  this->async = enabled;
+  #endif
+  if (!this->async) waitForFlush();
+}
+
+void OLEDDisplayI2C::startFlush() {
+  uint32_t start = micros();
+  uint8_t scroll[OLEDDISPLAY_SCROLL_COMMANDS];
+  uint8_t scrollLength = takeScroll(scroll);
+  this->flushCount = planFlush();
+  // The scroll step goes out first, the planned windows assume it
+  if (scrollLength) this->queue(OLEDDISPLAY_I2C_COMMANDS, scroll, scrollLength);
+  this->flushWindow = 0;
+  this->flushPage = this->flushCount ? flushWindows[0].minPage : 0;
+  this->flushTransactions = this->stats.transactions;
+  this->flushing = true;
+  this->flushMicros = micros() - start;
+}
+
+bool OLEDDisplayI2C::sendPage() {
+  if (this->flushWindow == this->flushCount) return false;
+
+  // The back buffer holds exactly what was planned, the front buffer is
+  // free for the next frame
+  #ifdef OLEDDISPLAY_DOUBLE_BUFFER
+  const uint8_t *source = buffer_back;
+  #else
+  const uint8_t *source = buffer;
+  #endif
+
+  const OLEDDISPLAY_WINDOW &window = flushWindows[this->flushWindow];
+  uint8_t width = window.maxX - window.minX + 1;
+  uint8_t y = this->flushPage;
+
+  if (this->pageAddressing) {
+    // Calculate the colum offset
+    uint8_t minBoundXp2H = (window.minX + 2) & 0x0F;
+    uint8_t minBoundXp2L = 0x10 | ((window.minX + 2) >> 4 );
+    uint8_t commands[] = { (uint8_t) (0xB0 + y), minBoundXp2H, minBoundXp2L };
+    this->queue(OLEDDISPLAY_I2C_COMMANDS, commands, sizeof(commands));
+    // The column pointer does not wrap to the next page
+    this->queue(OLEDDISPLAY_I2C_DATA, source + window.minX + y * DISPLAY_WIDTH, width);
+    this->flushTransfer();
+  } else {
+    if (y == window.minPage) {
+      uint8_t commands[] = { COLUMNADDR, window.minX, window.maxX, PAGEADDR, window.minPage, window.maxPage };
+      this->queue(OLEDDISPLAY_I2C_COMMANDS, commands, sizeof(commands));
+    }
+    // Data runs on into the next page, transactions may span pages
+    this->queue(OLEDDISPLAY_I2C_DATA, source + window.minX + y * DISPLAY_WIDTH, width);
+  }
+
+  if (y < window.maxPage) {
+    this->flushPage++;
+  } else if (++this->flushWindow < this->flushCount) {
+    this->flushPage = flushWindows[this->flushWindow].minPage;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void OLEDDisplayI2C::finishFlush() {
+  uint32_t start = micros();
+  this->flushTransfer();
+  this->holdCommands = false;
+  this->flushing = false;
+  this->flushMicros += micros() - start;
+
+  if (this->stats.transactions != this->flushTransactions) {
+    this->stats.frames++;
+    this->stats.frameMicros = this->flushMicros;
+    this->stats.maxFrameMicros = _max(this->stats.maxFrameMicros, this->flushMicros);
+    this->stats.totalMicros += this->flushMicros;
+  }
+}
+
+void OLEDDisplayI2C::resetBusStats() {
+  memset(&this->stats, 0, sizeof(this->stats));
+}
+
+void OLEDDisplayI2C::queue(uint8_t control, const uint8_t *bytes, uint16_t length) {
+  while (length) {
+    if (this->transferLength && this->transfer[0] != control) this->flushTransfer();
+    if (!this->transferLength) {
+      this->transfer[0] = control;
+      this->transferLength = 1;
+    }
+
+    uint16_t count = _min(length, (uint16_t) (this->transferLimit - this->transferLength));
+    memcpy(this->transfer + this->transferLength, bytes, count);
+    this->transferLength += count;
+    bytes += count;
+    length -= count;
+
+    if (this->transferLength == this->transferLimit) this->flushTransfer();
+  }
+}
+
+void OLEDDisplayI2C::flushTransfer() {
+  if (!this->transferLength) return;
+  this->bus.write(this->_address, this->transfer, this->transferLength);
+  this->stats.transactions++;
+  this->stats.bytes += this->transferLength + 1;
+  this->transferLength = 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 by Daniel Eichhorn
+ * Copyright (c) 2016 by Fabrice Weinberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OLEDDISPLAYI2C_h
+#define OLEDDISPLAYI2C_h
+
+#include "OLEDDisplay.h"
+
+// Largest transaction the transport assembles, control byte included.
+// Defaults to one full page row plus its control byte, backends with a
+// smaller buffer lower it in maxTransfer().
+#ifndef OLEDDISPLAY_I2C_BUFFER
+#define OLEDDISPLAY_I2C_BUFFER (DISPLAY_WIDTH + 1)
+#endif
+
+// Control bytes, Co = 0: everything up to the stop is commands or data
+#define OLEDDISPLAY_I2C_COMMANDS 0x00
+#define OLEDDISPLAY_I2C_DATA     0x40
+
+// Bus backend of the I2C drivers. write() sends one complete transaction:
+// start, address, the bytes and stop.
+class OLEDI2CBus {
+  public:
+    virtual bool begin() = 0;
+
+    // Bytes one transaction may carry after the address
+    virtual uint16_t maxTransfer() = 0;
+
+    virtual bool write(uint8_t address, const uint8_t *data, uint16_t length) = 0;
+};
+
+struct OLEDDISPLAY_BUS_STATS {
+  uint32_t frames;           // display() calls that sent anything
+  uint32_t transactions;
+  uint32_t bytes;            // bytes on the wire, address bytes included
+  uint32_t frameMicros;      // time the last frame spent sending, over all its pumps
+  uint32_t maxFrameMicros;
+  uint32_t totalMicros;      // all frames since resetBusStats()
+};
+
+// Buffered transport shared by the SSD1306 and SH1106 I2C drivers.
+//
+// Commands are packed into a single 0x00 control stream and data is sent
+// in the largest transaction the backend allows instead of one transaction
+// per command and per 16 data bytes. The drivers only choose the backend
+// and the addressing mode of their controller.
+class OLEDDisplayI2C : public OLEDDisplay {
+  public:
+    // Plans the flush and sends it, in asynchronous mode it is only
+    // started and pump() sends it page by page. A display() while a flush
+    // is still running is sent as soon as that one completes.
+    void display(void);
+    bool pump(void);
+
+    // Asynchronous flushing sends from the back buffer, so the next frame
+    // can be drawn while the previous one is on the bus. Needs
+    // OLEDDISPLAY_DOUBLE_BUFFER, without it flushes stay synchronous.
+    void setAsyncFlush(bool enabled);
+    bool flushInProgress() const override { return this->flushing || this->framePending; }
+
+    // Bus usage of the flushes since the last resetBusStats()
+    const OLEDDISPLAY_BUS_STATS &busStats() const { return this->stats; }
+    void resetBusStats();
+
+  protected:
+    OLEDDisplayI2C(uint8_t address, OLEDI2CBus &bus);
+
+    // SH1106 has no horizontal addressing mode, every page of a window is
+    // addressed on its own
+    bool                pageAddressing  = false;
+
+    bool connect();
+
+    // Commands outside of display() go out right away, the init sequence
+    // is held back and sent together with the first frame
+    void sendCommand(uint8_t com);
+
+  private:
+    uint8_t             _address;
+    OLEDI2CBus          &bus;
+    uint16_t            transferLimit   = OLEDDISPLAY_I2C_BUFFER;
+    bool                holdCommands    = false;
+
+    OLEDDISPLAY_BUS_STATS stats;
+
+    uint8_t             transfer[OLEDDISPLAY_I2C_BUFFER];
+    uint16_t            transferLength  = 0;
+
+    // Flush in progress: window and page sent next
+    bool                async           = false;
+    bool                flushing        = false;
+    bool                framePending    = false;
+    uint8_t             flushCount      = 0;
+    uint8_t             flushWindow     = 0;
+    uint8_t             flushPage       = 0;
+    uint32_t            flushMicros     = 0;
+    uint32_t            flushTransactions = 0;
+
+    void startFlush();
+    bool sendPage();
+    void finishFlush();
+
+    void queue(uint8_t control, const uint8_t *bytes, uint16_t length);
+    void flushTransfer();
+};
+
+#endif
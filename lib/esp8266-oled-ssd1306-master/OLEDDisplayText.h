@@ -0,0 +1,106 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 by Daniel Eichhorn
+ * Copyright (c) 2016 by Fabrice Weinberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OLEDDISPLAYTEXT_h
+#define OLEDDISPLAYTEXT_h
+
+#include <Arduino.h>
+
+// Short text assembled on the stack for the drawString() overloads taking
+// a pointer and a length. Nothing is allocated, text that does not fit
+// into `Size - 1` chars is cut off.
+//
+//   OLEDDisplayText<16> text;
+//   text.add(seconds).add('s').add(" -").addPercent(drop);
+//   display.drawString(0, 0, text.c_str(), text.length());
+template <uint8_t Size>
+class OLEDDisplayText {
+  public:
+    OLEDDisplayText() {
+      this->clear();
+    }
+
+    OLEDDisplayText &clear() {
+      this->used = 0;
+      this->text[0] = 0;
+      return *this;
+    }
+
+    OLEDDisplayText &add(char c) {
+      if (this->used + 1 < Size) {
+        this->text[this->used++] = c;
+        this->text[this->used] = 0;
+      }
+      return *this;
+    }
+
+    OLEDDisplayText &add(const char *s) {
+      while (*s) this->add(*s++);
+      return *this;
+    }
+
+    OLEDDisplayText &add(const __FlashStringHelper *s) {
+      const char *p = (const char *) s;
+      char c;
+      while ((c = pgm_read_byte(p++))) this->add(c);
+      return *this;
+    }
+
+    OLEDDisplayText &add(int value)           { return this->add((long) value); }
+    OLEDDisplayText &add(unsigned int value)  { return this->add((unsigned long) value); }
+
+    OLEDDisplayText &add(long value) {
+      if (value < 0) {
+        this->add('-');
+        return this->add(0UL - (unsigned long) value);
+      }
+      return this->add((unsigned long) value);
+    }
+
+    OLEDDisplayText &add(unsigned long value) {
+      // Less than 3 decimal digits per byte, whatever the width of long
+      char digits[sizeof(unsigned long) * 3];
+      uint8_t count = 0;
+      do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+      } while (value);
+      while (count) this->add(digits[--count]);
+      return *this;
+    }
+
+    OLEDDisplayText &addPercent(long value) {
+      return this->add(value).add('%');
+    }
+
+    const char *c_str() const { return this->text; }
+    uint8_t length() const { return this->used; }
+
+  private:
+    char      text[Size];
+    uint8_t   used;
+};
+
+#endif
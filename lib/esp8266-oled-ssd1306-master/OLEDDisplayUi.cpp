@@ -26,6 +26,23 @@
 
 #include "OLEDDisplayUi.h"
 
+// Eased progress at 32 steps of a transition in 1/65536, the last entry
+// stands for 1. Linear progress is computed exactly instead.
+static const uint16_t easingCurves[3][33] PROGMEM = {
+  // EASE_IN: t^2
+  {     0,    64,   256,   576,  1024,  1600,  2304,  3136,  4096,  5184,  6400,
+     7744,  9216, 10816, 12544, 14400, 16384, 18496, 20736, 23104, 25600, 28224,
+    30976, 33856, 36864, 40000, 43264, 46656, 50176, 53824, 57600, 61504, 65535 },
+  // EASE_OUT: 1 - (1 - t)^2
+  {     0,  4032,  7936, 11712, 15360, 18880, 22272, 25536, 28672, 31680, 34560,
+    37312, 39936, 42432, 44800, 47040, 49152, 51136, 52992, 54720, 56320, 57792,
+    59136, 60352, 61440, 62400, 63232, 63936, 64512, 64960, 65280, 65472, 65535 },
+  // EASE_IN_OUT: 3t^2 - 2t^3
+  {     0,   188,   736,  1620,  2816,  4300,  6048,  8036, 10240, 12636, 15200,
+    17908, 20736, 23660, 26656, 29700, 32768, 35836, 38880, 41876, 44800, 47628,
+    50336, 52900, 55296, 57500, 59488, 61236, 62720, 63916, 64800, 65348, 65535 }
+};
+
 OLEDDisplayUi::OLEDDisplayUi(OLEDDisplay *display) {
   this->display = display;
 }
@@ -78,23 +95,29 @@ void OLEDDisplayUi::disableIndicator(){
 
 void OLEDDisplayUi::enableAllIndicators(){
   this->shouldDrawIndicators = true;
+  this->invalidate();
 }
 
 void OLEDDisplayUi::disableAllIndicators(){
   this->shouldDrawIndicators = false;
+  this->invalidate();
 }
 
 void OLEDDisplayUi::setIndicatorPosition(IndicatorPosition pos) {
   this->indicatorPosition = pos;
+  this->invalidate();
 }
 void OLEDDisplayUi::setIndicatorDirection(IndicatorDirection dir) {
   this->indicatorDirection = dir;
+  this->invalidate();
 }
 void OLEDDisplayUi::setActiveSymbol(const char* symbol) {
   this->activeSymbol = symbol;
+  this->invalidate();
 }
 void OLEDDisplayUi::setInactiveSymbol(const char* symbol) {
   this->inactiveSymbol = symbol;
+  this->invalidate();
 }
 
 
@@ -102,16 +125,45 @@ void OLEDDisplayUi::setInactiveSymbol(const char* symbol) {
 void OLEDDisplayUi::setFrameAnimation(AnimationDirection dir) {
   this->frameAnimationDirection = dir;
 }
+void OLEDDisplayUi::setTransitionEasing(TransitionEasing easing) {
+  this->transitionEasing = easing;
+}
+
+bool OLEDDisplayUi::setTransitionCache(bool enabled) {
+  if (enabled && !this->transitionBuffer) {
+    this->transitionBuffer = (uint8_t*) malloc(sizeof(uint8_t) * DISPLAY_BUFFER_SIZE);
+    if (!this->transitionBuffer) {
+      DEBUG_OLEDDISPLAYUI("[OLEDDISPLAYUI][setTransitionCache] Not enough memory to cache frames\n");
+      enabled = false;
+    }
+  }
+  this->transitionCache = enabled;
+  this->cachedFrame = -1;
+  return enabled;
+}
+
 void OLEDDisplayUi::setFrames(FrameCallback* frameFunctions, uint8_t frameCount) {
   this->frameFunctions = frameFunctions;
   this->frameCount     = frameCount;
+  this->invalidateBackground();
   this->resetState();
 }
 
+void OLEDDisplayUi::setFrameBackgrounds(FrameCallback* backgroundFunctions) {
+  this->frameBackgrounds = backgroundFunctions;
+  this->invalidateBackground();
+}
+
+void OLEDDisplayUi::invalidateBackground() {
+  this->backgroundFrame = -1;
+  this->invalidate();
+}
+
 // -/----- Overlays ------\-
 void OLEDDisplayUi::setOverlays(OverlayCallback* overlayFunctions, uint8_t overlayCount){
   this->overlayFunctions = overlayFunctions;
   this->overlayCount     = overlayCount;
+  this->invalidate();
 }
 
 // -/----- Loading Process -----\-
@@ -128,6 +180,7 @@ void OLEDDisplayUi::runLoadingProcess(LoadingStage* stages, uint8_t stagesCount)
     display->clear();
     this->loadingDrawFunction(this->display, &stages[i], progress);
     display->display();
+    display->waitForFlush();
 
     stages[i].callback();
 
@@ -138,6 +191,7 @@ void OLEDDisplayUi::runLoadingProcess(LoadingStage* stages, uint8_t stagesCount)
   display->clear();
   this->loadingDrawFunction(this->display, &stages[stagesCount-1], progress);
   display->display();
+  display->waitForFlush();
 
   delay(150);
 }
@@ -169,6 +223,7 @@ void OLEDDisplayUi::switchToFrame(uint8_t frame) {
   this->state.frameState = FIXED;
   this->state.currentFrame = frame;
   this->state.isIndicatorDrawen = true;
+  this->invalidate();
 }
 
 void OLEDDisplayUi::transitionToFrame(uint8_t frame) {
@@ -183,6 +238,44 @@ void OLEDDisplayUi::transitionToFrame(uint8_t frame) {
 }
 
 
+// -/----- Render on demand -----\-
+void OLEDDisplayUi::setRenderOnDemand(bool enabled) {
+  this->renderOnDemand = enabled;
+  this->invalidate();
+}
+
+void OLEDDisplayUi::invalidate() {
+  this->invalidated = true;
+}
+
+bool OLEDDisplayUi::watch(const void *data, uint16_t size) {
+  if (this->watchCount == OLEDDISPLAYUI_MAX_WATCHES) return false;
+  OLEDDisplayUiWatch &watch = this->watches[this->watchCount++];
+  watch.data = data;
+  watch.size = size;
+  watch.hash = 0;
+  this->invalidate();
+  return true;
+}
+
+bool OLEDDisplayUi::watchesChanged() {
+  bool changed = false;
+  for (uint8_t i = 0; i < this->watchCount; i++) {
+    OLEDDisplayUiWatch &watch = this->watches[i];
+    // FNV-1a, a collision only delays a redraw until the next change
+    const uint8_t *bytes = (const uint8_t *) watch.data;
+    uint32_t hash = 2166136261UL;
+    for (uint16_t b = 0; b < watch.size; b++) {
+      hash = (hash ^ bytes[b]) * 16777619UL;
+    }
+    if (hash != watch.hash) {
+      watch.hash = hash;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
 // -/----- State information -----\-
 OLEDDisplayUiState* OLEDDisplayUi::getUiState(){
   return &this->state;
@@ -190,6 +283,9 @@ OLEDDisplayUiState* OLEDDisplayUi::getUiState(){
 
 
 int8_t OLEDDisplayUi::update(){
+  // Move an asynchronous flush on by one page per call
+  this->display->pump();
+
   long frameStart = millis();
   int8_t timeBudget = this->updateInterval - (frameStart - this->state.lastUpdate);
   if ( timeBudget <= 0) {
@@ -199,13 +295,36 @@ int8_t OLEDDisplayUi::update(){
     this->state.lastUpdate = frameStart;
     this->tick();
   }
+
+  // A flush sends one page per call, no time to spare until it is out
+  if (this->display->flushInProgress()) return 0;
+  if (this->renderOnDemand) return this->idleTime();
   return this->updateInterval - (millis() - frameStart);
 }
 
+int8_t OLEDDisplayUi::idleTime() {
+  long elapsed = millis() - this->state.lastUpdate;
+
+  // Watched variables are only seen by a tick, an invalidation or a
+  // transition is drawn by the next one
+  if (this->watchCount || this->invalidated || this->state.frameState != FIXED) {
+    return this->updateInterval - elapsed;
+  }
+
+  long remaining = 127;
+  if (this->autoTransition && this->ticksPerFrame > this->state.ticksSinceLastStateSwitch) {
+    remaining = (long) (this->ticksPerFrame - this->state.ticksSinceLastStateSwitch) * this->updateInterval - elapsed;
+  }
+  return remaining > 127 ? 127 : remaining;
+}
+
 
-void OLEDDisplayUi::tick() {
+bool OLEDDisplayUi::tick() {
   this->state.ticksSinceLastStateSwitch++;
 
+  FrameState frameState = this->state.frameState;
+  uint8_t currentFrame = this->state.currentFrame;
+
   switch (this->state.frameState) {
     case IN_TRANSITION:
         if (this->state.ticksSinceLastStateSwitch >= this->ticksPerTransition){
@@ -230,6 +349,15 @@ void OLEDDisplayUi::tick() {
       break;
   }
 
+  // Every watch is hashed on every tick so none misses a change
+  bool changed = this->watchesChanged() || this->invalidated;
+  if (this->renderOnDemand && !changed && frameState == FIXED &&
+      this->state.frameState == FIXED && this->state.currentFrame == currentFrame) {
+    return false;
+  }
+  this->invalidated = false;
+
+  this->prepareBackground();
   this->display->clear();
   this->drawFrame();
   if (shouldDrawIndicators) {
@@ -237,9 +365,11 @@ void OLEDDisplayUi::tick() {
   }
   this->drawOverlays();
   this->display->display();
+  return true;
 }
 
 void OLEDDisplayUi::resetState() {
+  this->invalidate();
   this->state.lastUpdate = 0;
   this->state.ticksSinceLastStateSwitch = 0;
   this->state.frameState = FIXED;
@@ -247,35 +377,84 @@ void OLEDDisplayUi::resetState() {
   this->state.isIndicatorDrawen = true;
 }
 
+void OLEDDisplayUi::prepareBackground() {
+  FrameCallback background = NULL;
+  if (this->frameBackgrounds && this->state.frameState == FIXED) {
+    background = this->frameBackgrounds[this->state.currentFrame];
+  }
+  if (background && this->backgroundFrame == this->state.currentFrame) return;
+
+  // Transitions move the backgrounds, drawFrame() draws them directly
+  this->display->dropBackground();
+  this->backgroundFrame = -1;
+  if (!background) return;
+
+  this->display->clear();
+  background(this->display, &this->state, 0, 0);
+  if (this->display->saveBackground()) {
+    this->backgroundFrame = this->state.currentFrame;
+  }
+}
+
+void OLEDDisplayUi::drawBackground(uint8_t frame, int16_t x, int16_t y) {
+  if (!this->frameBackgrounds || this->backgroundFrame == frame) return;
+  FrameCallback background = this->frameBackgrounds[frame];
+  if (background) background(this->display, &this->state, x, y);
+}
+
+uint16_t OLEDDisplayUi::transitionProgress() {
+  // Integer tick counts only, floats are emulated on the ESP8266
+  if (this->state.ticksSinceLastStateSwitch >= this->ticksPerTransition) return 0xFFFF;
+  uint16_t linear = ((uint32_t) this->state.ticksSinceLastStateSwitch << 16) / this->ticksPerTransition;
+  if (this->transitionEasing == EASE_LINEAR) return linear;
+
+  const uint16_t *curve = easingCurves[this->transitionEasing - EASE_IN];
+  uint8_t step = linear >> 11;
+  uint16_t from = pgm_read_word(curve + step);
+  uint16_t to = pgm_read_word(curve + step + 1);
+  return from + (((uint32_t) (to - from) * (linear & 0x7FF)) >> 11);
+}
+
+void OLEDDisplayUi::cacheFrame(uint8_t frame) {
+  // Called right after clear(), the layer is dropped during transitions
+  this->enableIndicator();
+  this->drawBackground(frame, 0, 0);
+  (this->frameFunctions[frame])(this->display, &this->state, 0, 0);
+  this->cachedIndicator = this->state.isIndicatorDrawen;
+  memcpy(this->transitionBuffer, this->display->buffer, DISPLAY_BUFFER_SIZE);
+  this->display->clear();
+  this->cachedFrame = frame;
+}
+
 void OLEDDisplayUi::drawFrame(){
   switch (this->state.frameState){
      case IN_TRANSITION: {
-       float progress = (float) this->state.ticksSinceLastStateSwitch / (float) this->ticksPerTransition;
+       uint32_t progress = this->transitionProgress();
        int16_t x, y, x1, y1;
        switch(this->frameAnimationDirection){
         case SLIDE_LEFT:
-          x = -128 * progress;
+          x = -(int16_t) ((DISPLAY_WIDTH * progress) >> 16);
           y = 0;
-          x1 = x + 128;
+          x1 = x + DISPLAY_WIDTH;
           y1 = 0;
           break;
         case SLIDE_RIGHT:
-          x = 128 * progress;
+          x = (DISPLAY_WIDTH * progress) >> 16;
           y = 0;
-          x1 = x - 128;
+          x1 = x - DISPLAY_WIDTH;
           y1 = 0;
           break;
         case SLIDE_UP:
           x = 0;
-          y = -64 * progress;
+          y = -(int16_t) ((DISPLAY_HEIGHT * progress) >> 16);
           x1 = 0;
-          y1 = y + 64;
+          y1 = y + DISPLAY_HEIGHT;
           break;
         case SLIDE_DOWN:
           x = 0;
-          y = 64 * progress;
+          y = (DISPLAY_HEIGHT * progress) >> 16;
           x1 = 0;
-          y1 = y - 64;
+          y1 = y - DISPLAY_HEIGHT;
           break;
        }
 
@@ -287,11 +466,19 @@ void OLEDDisplayUi::drawFrame(){
 
 
        // Prope each frameFunction for the indicator Drawen state
-       this->enableIndicator();
-       (this->frameFunctions[this->state.currentFrame])(this->display, &this->state, x, y);
-       drawenCurrentFrame = this->state.isIndicatorDrawen;
+       if (this->transitionCache) {
+         if (this->cachedFrame != this->state.currentFrame) this->cacheFrame(this->state.currentFrame);
+         this->display->drawBuffer(x, y, this->transitionBuffer);
+         drawenCurrentFrame = this->cachedIndicator;
+       } else {
+         this->enableIndicator();
+         this->drawBackground(this->state.currentFrame, x, y);
+         (this->frameFunctions[this->state.currentFrame])(this->display, &this->state, x, y);
+         drawenCurrentFrame = this->state.isIndicatorDrawen;
+       }
 
        this->enableIndicator();
+       this->drawBackground(this->getNextFrameNumber(), x1, y1);
        (this->frameFunctions[this->getNextFrameNumber()])(this->display, &this->state, x1, y1);
 
        // Build up the indicatorDrawState
@@ -316,7 +503,9 @@ void OLEDDisplayUi::drawFrame(){
       // Always assume that the indicator is drawn!
       // And set indicatorDrawState to "not known yet"
       this->indicatorDrawState = 0;
+      this->cachedFrame = -1;
       this->enableIndicator();
+      this->drawBackground(this->state.currentFrame, 0, 0);
       (this->frameFunctions[this->state.currentFrame])(this->display, &this->state, 0, 0);
       break;
   }
@@ -332,7 +521,8 @@ void OLEDDisplayUi::drawIndicator() {
     }
 
     uint8_t posOfHighlightFrame;
-    float indicatorFadeProgress = 0;
+    // Pixels the indicator is moved out of the display, 0..8
+    int16_t indicatorFade = 0;
 
     // if the indicator needs to be slided in we want to
     // highlight the next frame in the transition
@@ -352,11 +542,11 @@ void OLEDDisplayUi::drawIndicator() {
     switch (this->indicatorDrawState) {
       case 1: // Indicator was not drawn in this frame but will be in next
         // Slide IN
-        indicatorFadeProgress = 1 - ((float) this->state.ticksSinceLastStateSwitch / (float) this->ticksPerTransition);
+        indicatorFade = (8 * (0x10000 - (uint32_t) this->transitionProgress())) >> 16;
         break;
       case 2: // Indicator was drawn in this frame but not in next
         // Slide OUT
-        indicatorFadeProgress = ((float) this->state.ticksSinceLastStateSwitch / (float) this->ticksPerTransition);
+        indicatorFade = (8 * (uint32_t) this->transitionProgress()) >> 16;
         break;
     }
 
@@ -367,20 +557,20 @@ void OLEDDisplayUi::drawIndicator() {
 
       switch (this->indicatorPosition){
         case TOP:
-          y = 0 - (8 * indicatorFadeProgress);
-          x = 64 - frameStartPos + 12 * i;
+          y = 0 - indicatorFade;
+          x = DISPLAY_WIDTH / 2 - frameStartPos + 12 * i;
           break;
         case BOTTOM:
-          y = 56 + (8 * indicatorFadeProgress);
-          x = 64 - frameStartPos + 12 * i;
+          y = DISPLAY_HEIGHT - 8 + indicatorFade;
+          x = DISPLAY_WIDTH / 2 - frameStartPos + 12 * i;
           break;
         case RIGHT:
-          x = 120 + (8 * indicatorFadeProgress);
-          y = 32 - frameStartPos + 2 + 12 * i;
+          x = DISPLAY_WIDTH - 8 + indicatorFade;
+          y = DISPLAY_HEIGHT / 2 - frameStartPos + 2 + 12 * i;
           break;
         case LEFT:
-          x = 0 - (8 * indicatorFadeProgress);
-          y = 32 - frameStartPos + 2 + 12 * i;
+          x = 0 - indicatorFade;
+          y = DISPLAY_HEIGHT / 2 - frameStartPos + 2 + 12 * i;
           break;
       }
 
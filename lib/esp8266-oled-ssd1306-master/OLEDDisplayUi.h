@@ -36,6 +36,11 @@
 #define DEBUG_OLEDDISPLAYUI(...)
 #endif
 
+// Variables render on demand can watch for changes
+#ifndef OLEDDISPLAYUI_MAX_WATCHES
+#define OLEDDISPLAYUI_MAX_WATCHES 8
+#endif
+
 enum AnimationDirection {
   SLIDE_UP,
   SLIDE_DOWN,
@@ -43,6 +48,14 @@ enum AnimationDirection {
   SLIDE_RIGHT
 };
 
+// Progress of a transition over time
+enum TransitionEasing {
+  EASE_LINEAR,
+  EASE_IN,
+  EASE_OUT,
+  EASE_IN_OUT
+};
+
 enum IndicatorPosition {
   TOP,
   RIGHT,
@@ -89,6 +102,12 @@ struct OLEDDisplayUiState {
   void*         userData                  = NULL;
 };
 
+struct OLEDDisplayUiWatch {
+  const void*   data;
+  uint16_t      size;
+  uint32_t      hash;
+};
+
 struct LoadingStage {
   const char* process;
   void (*callback)();
@@ -116,6 +135,14 @@ class OLEDDisplayUi {
 
     int8_t              lastTransitionDirection   = 1;
 
+    TransitionEasing    transitionEasing          = EASE_LINEAR;
+
+    // Outgoing frame rendered once per transition, -1 while not cached
+    uint8_t            *transitionBuffer          = NULL;
+    bool                transitionCache           = false;
+    int16_t             cachedFrame               = -1;
+    bool                cachedIndicator           = true;
+
     uint16_t            ticksPerFrame             = 151; // ~ 5000ms at 30 FPS
     uint16_t            ticksPerTransition        = 15;  // ~  500ms at 30 FPS
 
@@ -124,6 +151,12 @@ class OLEDDisplayUi {
     FrameCallback*      frameFunctions;
     uint8_t             frameCount                = 0;
 
+    // Values for frame backgrounds
+    FrameCallback*      frameBackgrounds          = NULL;
+
+    // Frame whose background is saved in the display layer, -1 if none
+    int16_t             backgroundFrame           = -1;
+
     // Internally used to transition to a specific frame
     int8_t              nextFrameNumber           = -1;
 
@@ -142,8 +175,8 @@ class OLEDDisplayUi {
     LoadingDrawFunction loadingDrawFunction       = [](OLEDDisplay *display, LoadingStage* stage, uint8_t progress) {
       display->setTextAlignment(TEXT_ALIGN_CENTER);
       display->setFont(ArialMT_Plain_10);
-      display->drawString(64, 18, stage->process);
-      display->drawProgressBar(4, 32, 120, 8, progress);
+      display->drawString(DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2 - 14, stage->process);
+      display->drawProgressBar(4, DISPLAY_HEIGHT / 2, DISPLAY_WIDTH - 8, 8, progress);
     };
 
     // UI State
@@ -152,11 +185,24 @@ class OLEDDisplayUi {
     // Bookeeping for update
     uint8_t             updateInterval            = 33;
 
+    // Render on demand: redraw only when invalidated, in transition or
+    // when a watched variable changed
+    bool                renderOnDemand            = false;
+    bool                invalidated               = true;
+    OLEDDisplayUiWatch  watches[OLEDDISPLAYUI_MAX_WATCHES];
+    uint8_t             watchCount                = 0;
+
     uint8_t             getNextFrameNumber();
     void                drawIndicator();
+    void                prepareBackground();
+    void                drawBackground(uint8_t frame, int16_t x, int16_t y);
+    uint16_t            transitionProgress();
+    void                cacheFrame(uint8_t frame);
     void                drawFrame();
     void                drawOverlays();
-    void                tick();
+    bool                watchesChanged();
+    int8_t              idleTime();
+    bool                tick();
     void                resetState();
 
   public:
@@ -255,11 +301,38 @@ class OLEDDisplayUi {
      */
     void setFrameAnimation(AnimationDirection dir);
 
+    /**
+     * Configure how the frames move over the time of a transition
+     */
+    void setTransitionEasing(TransitionEasing easing);
+
+    /**
+     * Draw the outgoing frame once when a transition starts and slide that
+     * copy instead of calling its frame function on every tick. The frame
+     * stands still during the transition. Needs a second frame buffer,
+     * returns false if it could not be allocated.
+     */
+    bool setTransitionCache(bool enabled);
+
     /**
      * Add frame drawing functions
      */
     void setFrames(FrameCallback* frameFunctions, uint8_t frameCount);
 
+    /**
+     * Add background drawing functions, one per frame in the same order
+     * as the frames, NULL for frames without one. While a frame is shown
+     * without transition its background is drawn once and kept as the
+     * display's background layer.
+     */
+    void setFrameBackgrounds(FrameCallback* backgroundFunctions);
+
+    /**
+     * Draw the background of the current frame again on the next tick,
+     * call this when what it shows has changed.
+     */
+    void invalidateBackground();
+
     // Overlay
 
     /**
@@ -297,9 +370,41 @@ class OLEDDisplayUi {
      */
     void transitionToFrame(uint8_t frame);
 
+    // Render on demand
+
+    /**
+     * Only run the frames, overlays and display() when something changed:
+     * a transition is running, invalidate() was called or a watched
+     * variable changed. Off by default, every tick redraws.
+     */
+    void setRenderOnDemand(bool enabled);
+
+    /**
+     * Redraw on the next tick. Call it wherever the shown values change,
+     * update() then lets loop() sleep until the next transition.
+     */
+    void invalidate();
+
+    /**
+     * Redraw whenever the `size` bytes at `data` change, they are checked
+     * once per tick. A fallback for values set where invalidate() cannot
+     * be called: while anything is watched update() never returns more
+     * than the frame interval. Returns false if OLEDDISPLAYUI_MAX_WATCHES
+     * variables are watched already.
+     */
+    bool watch(const void *data, uint16_t size);
+
     // State Info
     OLEDDisplayUiState* getUiState();
 
+    // Call from loop() as often as possible, also pumps asynchronous
+    // display flushes. Returns the time left until the next frame is due,
+    // when rendering on demand with nothing invalidated or watched the time
+    // until the next automatic transition (127 ms at most). An invalidate()
+    // during that sleep is only seen by the next update(), loops with other
+    // work wake up for it. While a flush is still
+    // being sent it returns 0, so loop() comes back for the next page
+    // instead of sleeping between pages.
     int8_t update();
 };
 #endif
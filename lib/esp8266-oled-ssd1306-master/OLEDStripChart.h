@@ -0,0 +1,214 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 by Daniel Eichhorn
+ * Copyright (c) 2016 by Fabrice Weinberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OLEDSTRIPCHART_h
+#define OLEDSTRIPCHART_h
+
+#include "OLEDDisplay.h"
+
+// Scrolling chart of `Width` columns and `Pages` * 8 rows.
+//
+// Every column is a vertical span, rendered once into column-major page
+// bytes when it arrives. The columns form a ring, so scrolling by one
+// column only moves the ring head, and draw() hands the ring to
+// drawFastImage() in at most two pieces, oldest column on the left.
+//
+//   OLEDStripChart<128, 8> chart;
+//   chart.setRange(26, 89);
+//   chart.push(value);            // connected to the previous value
+//   chart.draw(&display, 0, 0);
+//
+// Values map onto the rows with a 16.16 fixed-point scale, the maximum at
+// the top row and the minimum at the bottom row. Values outside the range
+// are drawn at the edge. With autoscaling the range follows the columns
+// currently shown: it grows as soon as a column leaves it and shrinks once
+// per `Width` columns, every change renders all columns again.
+template <uint8_t Width, uint8_t Pages>
+class OLEDStripChart {
+  static_assert(Width > 0 && Pages > 0 && Pages <= 8, "OLEDStripChart needs 1..255 columns and 1..8 pages");
+
+  public:
+    OLEDStripChart() {
+      this->clear();
+    }
+
+    void clear() {
+      this->head = 0;
+      this->count = 0;
+      this->hasPrevious = false;
+    }
+
+    // Fixed range, turns autoscaling off
+    void setRange(int16_t minimum, int16_t maximum) {
+      this->autoScale = false;
+      this->scaleTo(minimum, maximum);
+    }
+
+    // Follow the values shown, the range never gets narrower than
+    // `minimumSpan`
+    void setAutoScale(uint16_t minimumSpan = 1) {
+      this->autoScale = true;
+      this->minimumSpan = minimumSpan ? minimumSpan : 1;
+      this->fitRange();
+    }
+
+    // Add a column spanning from the previous value to `value`. Both
+    // return true if the columns shown before just moved one column to the
+    // left, the display can then scroll them in hardware (scrollBand()).
+    bool push(int16_t value) {
+      int16_t low = value;
+      int16_t high = value;
+      if (this->hasPrevious) {
+        if (this->previous < low) low = this->previous;
+        if (this->previous > high) high = this->previous;
+      }
+      this->previous = value;
+      this->hasPrevious = true;
+      return this->pushSpan(low, high);
+    }
+
+    // Add a column covering low..high
+    bool pushSpan(int16_t low, int16_t high) {
+      if (low > high) {
+        int16_t swap = low;
+        low = high;
+        high = swap;
+      }
+      bool scrolled = this->count == Width;
+      uint8_t column = this->head;
+      this->lows[column] = low;
+      this->highs[column] = high;
+      if (++this->head == Width) this->head = 0;
+      if (this->count < Width) this->count++;
+
+      if (this->autoScale && (low < this->minimum || high > this->maximum || this->head == 0)) {
+        if (this->fitRange()) return false;
+      }
+      this->render(column);
+      return scrolled;
+    }
+
+    uint8_t size() const { return this->count; }
+    int16_t rangeMinimum() const { return this->minimum; }
+    int16_t rangeMaximum() const { return this->maximum; }
+
+    // Draw with the oldest column at x and the top row at y, in the
+    // current color of the display
+    void draw(OLEDDisplay *display, int16_t x, int16_t y) const {
+      uint8_t oldest = this->head >= this->count ? this->head - this->count : this->head + Width - this->count;
+      uint8_t first = _min((uint16_t) this->count, (uint16_t) (Width - oldest));
+      if (first) {
+        display->drawFastImage(x, y, first, Pages * 8, (const char *) this->raster + oldest * Pages);
+      }
+      if (this->count > first) {
+        display->drawFastImage(x + first, y, this->count - first, Pages * 8, (const char *) this->raster);
+      }
+    }
+
+  private:
+    int16_t   lows[Width];
+    int16_t   highs[Width];
+    uint8_t   raster[Width * Pages];
+
+    uint8_t   head          = 0;
+    uint8_t   count         = 0;
+    bool      hasPrevious   = false;
+    int16_t   previous      = 0;
+
+    bool      autoScale     = false;
+    uint16_t  minimumSpan   = 1;
+    int16_t   minimum       = 0;
+    int16_t   maximum       = Pages * 8 - 1;
+    int32_t   scale         = 1L << 16; // rows per value, 16.16
+
+    void scaleTo(int16_t minimum, int16_t maximum) {
+      if (maximum <= minimum) {
+        if (minimum == INT16_MAX) minimum--;
+        maximum = minimum + 1;
+      }
+      this->minimum = minimum;
+      this->maximum = maximum;
+      this->scale = ((int32_t) (Pages * 8 - 1) << 16) / ((int32_t) maximum - minimum);
+      this->renderAll();
+    }
+
+    // Fit the range to the columns shown, returns true if it changed
+    bool fitRange() {
+      if (!this->count) return false;
+      int32_t low = INT16_MAX;
+      int32_t high = INT16_MIN;
+      for (uint8_t i = 0; i < this->count; i++) {
+        uint8_t column = this->head >= i + 1 ? this->head - i - 1 : this->head + Width - i - 1;
+        if (this->lows[column] < low) low = this->lows[column];
+        if (this->highs[column] > high) high = this->highs[column];
+      }
+      int32_t missing = (int32_t) this->minimumSpan - (high - low);
+      if (missing > 0) {
+        low -= missing / 2;
+        if (low < INT16_MIN) low = INT16_MIN;
+        high = low + this->minimumSpan;
+        if (high > INT16_MAX) {
+          high = INT16_MAX;
+          low = high - this->minimumSpan;
+        }
+      }
+      if (low == this->minimum && high == this->maximum) return false;
+      this->scaleTo(low, high);
+      return true;
+    }
+
+    uint8_t row(int16_t value) const {
+      if (value <= this->minimum) return Pages * 8 - 1;
+      if (value >= this->maximum) return 0;
+      int32_t offset = ((int32_t) value - this->minimum) * this->scale;
+      return Pages * 8 - 1 - (uint8_t) ((offset + 0x8000) >> 16);
+    }
+
+    void renderAll() {
+      for (uint8_t i = 0; i < this->count; i++) {
+        this->render(this->head >= i + 1 ? this->head - i - 1 : this->head + Width - i - 1);
+      }
+    }
+
+    // Page masks of rows top..bottom, the same way drawVerticalLine() fills
+    void render(uint8_t column) {
+      uint8_t top = this->row(this->highs[column]);
+      uint8_t bottom = this->row(this->lows[column]);
+      uint8_t *bytes = this->raster + column * Pages;
+      for (uint8_t page = 0; page < Pages; page++) {
+        uint8_t first = page * 8;
+        if (bottom < first || top > first + 7) {
+          bytes[page] = 0;
+          continue;
+        }
+        uint8_t mask = 0xFF;
+        if (top > first) mask &= 0xFF << (top - first);
+        if (bottom < first + 7) mask &= 0xFF >> (first + 7 - bottom);
+        bytes[page] = mask;
+      }
+    }
+};
+
+#endif
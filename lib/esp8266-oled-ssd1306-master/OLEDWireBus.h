@@ -0,0 +1,63 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 by Daniel Eichhorn
+ * Copyright (c) 2016 by Fabrice Weinberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OLEDWireBus_h
+#define OLEDWireBus_h
+
+#include "OLEDDisplayI2C.h"
+#include <Wire.h>
+
+// Arduino TwoWire backend, a transaction is limited to the Wire buffer
+class OLEDWireBus : public OLEDI2CBus {
+  private:
+      uint8_t             _sda;
+      uint8_t             _scl;
+
+  public:
+    OLEDWireBus(uint8_t _sda, uint8_t _scl) {
+      this->_sda = _sda;
+      this->_scl = _scl;
+    }
+
+    bool begin() {
+      Wire.begin(this->_sda, this->_scl);
+      // Let's use ~700khz if ESP8266 is in 160Mhz mode
+      // this will be limited to ~400khz if the ESP8266 in 80Mhz mode.
+      Wire.setClock(700000);
+      return true;
+    }
+
+    uint16_t maxTransfer() {
+      return BUFFER_LENGTH;
+    }
+
+    bool write(uint8_t address, const uint8_t *data, uint16_t length) {
+      Wire.beginTransmission(address);
+      Wire.write(data, length);
+      return Wire.endTransmission() == 0;
+    }
+};
+
+#endif
@@ -28,105 +28,20 @@
 #ifndef SH1106Brzo_h
 #define SH1106Brzo_h
 
-#include "OLEDDisplay.h"
-#include <brzo_i2c.h>
+#include "OLEDDisplayI2C.h"
+#include "OLEDBrzoBus.h"
 
-#if F_CPU == 160000000L
-  #define BRZO_I2C_SPEED 1000
-#else
-  #define BRZO_I2C_SPEED 800
-#endif
-
-class SH1106Brzo : public OLEDDisplay {
+class SH1106Brzo : public OLEDDisplayI2C {
   private:
-      uint8_t             _address;
-      uint8_t             _sda;
-      uint8_t             _scl;
+      OLEDBrzoBus         _bus;
 
   public:
-    SH1106Brzo(uint8_t _address, uint8_t _sda, uint8_t _scl) {
-      this->_address = _address;
-      this->_sda = _sda;
-      this->_scl = _scl;
-    }
-
-    bool connect(){
-      brzo_i2c_setup(_sda, _scl, 0);
-      return true;
-    }
-
-    void display(void) {
-    #ifdef OLEDDISPLAY_DOUBLE_BUFFER
-       uint8_t minBoundY = ~0;
-       uint8_t maxBoundY = 0;
-
-       uint8_t minBoundX = ~0;
-       uint8_t maxBoundX = 0;
-       uint8_t x, y;
-
-       // Calculate the Y bounding box of changes
-       // and copy buffer[pos] to buffer_back[pos];
-       for (y = 0; y < (DISPLAY_HEIGHT / 8); y++) {
-         for (x = 0; x < DISPLAY_WIDTH; x++) {
-          uint16_t pos = x + y * DISPLAY_WIDTH;
-          if (buffer[pos] != buffer_back[pos]) {
-            minBoundY = _min(minBoundY, y);
-            maxBoundY = _max(maxBoundY, y);
-            minBoundX = _min(minBoundX, x);
-            maxBoundX = _max(maxBoundX, x);
-          }
-          buffer_back[pos] = buffer[pos];
-        }
-        yield();
-       }
-
-       // If the minBoundY wasn't updated
-       // we can savely assume that buffer_back[pos] == buffer[pos]
-       // holdes true for all values of pos
-       if (minBoundY == ~0) return;
-
-       byte k = 0;
-       uint8_t sendBuffer[17];
-       sendBuffer[0] = 0x40;
-
-       // Calculate the colum offset 
-       uint8_t minBoundXp2H = (minBoundX + 2) & 0x0F;
-       uint8_t minBoundXp2L = 0x10 | ((minBoundX + 2) >> 4 );
-
-       brzo_i2c_start_transaction(this->_address, BRZO_I2C_SPEED);
-
-       for (y = minBoundY; y <= maxBoundY; y++) {
-         sendCommand(0xB0 + y);
-         sendCommand(minBoundXp2H);
-         sendCommand(minBoundXp2L);
-         for (x = minBoundX; x <= maxBoundX; x++) {
-             k++;
-             sendBuffer[k] = buffer[x + y * DISPLAY_WIDTH];
-             if (k == 16)  {
-               brzo_i2c_write(sendBuffer, 17, true);
-               k = 0;
-             }
-         }
-         if (k != 0) {
-           brzo_i2c_write(sendBuffer, k + 1, true);
-           k = 0;
-         }
-         yield();
-       }
-       if (k != 0) {
-         brzo_i2c_write(sendBuffer, k + 1, true);
-       }
-       brzo_i2c_end_transaction();
-     #else
-     #endif
-    }
-
-  private:
-    inline void sendCommand(uint8_t com) __attribute__((always_inline)){
-      uint8_t command[2] = {0x80 /* command mode */, com};
-      brzo_i2c_start_transaction(_address, BRZO_I2C_SPEED);
-      brzo_i2c_write(command, 2, true);
-      brzo_i2c_end_transaction();
+    SH1106Brzo(uint8_t _address, uint8_t _sda, uint8_t _scl) : OLEDDisplayI2C(_address, _bus), _bus(_sda, _scl) {
+      // Page addressing, every page of a window costs three packed commands
+      // and a new data transaction
+      this->pageAddressing = true;
+      this->windowCost = 0;
+      this->pageCost = 8;
     }
 };
 
@@ -41,6 +41,9 @@ class SH1106Spi : public OLEDDisplay {
     SH1106Spi(uint8_t _rst, uint8_t _dc) {
       this->_rst = _rst;
       this->_dc  = _dc;
+      // Page addressing, every page of a window costs three commands
+      this->windowCost = 0;
+      this->pageCost = 6;
     }
 
     bool connect(){
@@ -60,62 +63,26 @@ class SH1106Spi : public OLEDDisplay {
     }
 
     void display(void) {
-    #ifdef OLEDDISPLAY_DOUBLE_BUFFER
-       uint8_t minBoundY = ~0;
-       uint8_t maxBoundY = 0;
-
-       uint8_t minBoundX = ~0;
-       uint8_t maxBoundX = 0;
-
-       uint8_t x, y;
-
-       // Calculate the Y bounding box of changes
-       // and copy buffer[pos] to buffer_back[pos];
-       for (y = 0; y < (DISPLAY_HEIGHT / 8); y++) {
-         for (x = 0; x < DISPLAY_WIDTH; x++) {
-          uint16_t pos = x + y * DISPLAY_WIDTH;
-          if (buffer[pos] != buffer_back[pos]) {
-            minBoundY = _min(minBoundY, y);
-            maxBoundY = _max(maxBoundY, y);
-            minBoundX = _min(minBoundX, x);
-            maxBoundX = _max(maxBoundX, x);
-          }
-          buffer_back[pos] = buffer[pos];
-        }
-        yield();
-       }
-
-       // If the minBoundY wasn't updated
-       // we can savely assume that buffer_back[pos] == buffer[pos]
-       // holdes true for all values of pos
-       if (minBoundY == ~0) return;
-
-       // Calculate the colum offset
-       uint8_t minBoundXp2H = (minBoundX + 2) & 0x0F;
-       uint8_t minBoundXp2L = 0x10 | ((minBoundX + 2) >> 4 );
-
-       for (y = minBoundY; y <= maxBoundY; y++) {
-         sendCommand(0xB0 + y);
-         sendCommand(minBoundXp2H);
-         sendCommand(minBoundXp2L);
-         digitalWrite(_dc, HIGH);   // data mode
-         for (x = minBoundX; x <= maxBoundX; x++) {
-           SPI.transfer(buffer[x + y * DISPLAY_WIDTH]);
+       uint8_t windows = planFlush();
+
+       for (uint8_t w = 0; w < windows; w++) {
+         const OLEDDISPLAY_WINDOW &window = flushWindows[w];
+
+         // Calculate the colum offset
+         uint8_t minBoundXp2H = (window.minX + 2) & 0x0F;
+         uint8_t minBoundXp2L = 0x10 | ((window.minX + 2) >> 4 );
+
+         for (uint8_t y = window.minPage; y <= window.maxPage; y++) {
+           sendCommand(0xB0 + y);
+           sendCommand(minBoundXp2H);
+           sendCommand(minBoundXp2L);
+           digitalWrite(_dc, HIGH);   // data mode
+           for (uint8_t x = window.minX; x <= window.maxX; x++) {
+             SPI.transfer(buffer[x + y * DISPLAY_WIDTH]);
+           }
+           yield();
          }
-         yield();
        }
-     #else
-      for (uint8_t y=0; y<DISPLAY_HEIGHT/8; y++) {
-        sendCommand(0xB0 + y);
-        sendCommand(0x02);
-        sendCommand(0x10);
-        digitalWrite(_dc, HIGH);   // data mode
-        for( uint8_t x=0; x < DISPLAY_WIDTH; x++) {
-          SPI.transfer(buffer[x + y * DISPLAY_WIDTH]);
-        }
-        yield();
-      }
-     #endif
     }
 
   private:
@@ -48,6 +48,9 @@ class SSD1306Spi : public OLEDDisplay {
       this->_rst = _rst;
       this->_dc  = _dc;
       this->_cs  = _cs;
+      // Commands only toggle the pins, a window is cheap on SPI
+      this->windowCost = 12;
+      this->contentScroll = true;
     }
 
     bool connect(){
@@ -68,73 +71,36 @@ class SSD1306Spi : public OLEDDisplay {
     }
 
     void display(void) {
-    #ifdef OLEDDISPLAY_DOUBLE_BUFFER
-       uint8_t minBoundY = ~0;
-       uint8_t maxBoundY = 0;
-
-       uint8_t minBoundX = ~0;
-       uint8_t maxBoundX = 0;
-
-       uint8_t x, y;
-
-       // Calculate the Y bounding box of changes
-       // and copy buffer[pos] to buffer_back[pos];
-       for (y = 0; y < (DISPLAY_HEIGHT / 8); y++) {
-         for (x = 0; x < DISPLAY_WIDTH; x++) {
-          uint16_t pos = x + y * DISPLAY_WIDTH;
-          if (buffer[pos] != buffer_back[pos]) {
-            minBoundY = _min(minBoundY, y);
-            maxBoundY = _max(maxBoundY, y);
-            minBoundX = _min(minBoundX, x);
-            maxBoundX = _max(maxBoundX, x);
-          }
-          buffer_back[pos] = buffer[pos];
-        }
-        yield();
+       uint8_t scroll[OLEDDISPLAY_SCROLL_COMMANDS];
+       uint8_t scrollLength = takeScroll(scroll);
+       for (uint8_t i = 0; i < scrollLength; i++) {
+         sendCommand(scroll[i]);
        }
 
-       // If the minBoundY wasn't updated
-       // we can savely assume that buffer_back[pos] == buffer[pos]
-       // holdes true for all values of pos
-       if (minBoundY == ~0) return;
-
-       sendCommand(COLUMNADDR);
-       sendCommand(minBoundX);
-       sendCommand(maxBoundX);
-
-       sendCommand(PAGEADDR);
-       sendCommand(minBoundY);
-       sendCommand(maxBoundY);
-
-       digitalWrite(_cs, HIGH);
-       digitalWrite(_dc, HIGH);   // data mode
-       digitalWrite(_cs, LOW);
-       for (y = minBoundY; y <= maxBoundY; y++) {
-         for (x = minBoundX; x <= maxBoundX; x++) {
-           SPI.transfer(buffer[x + y * DISPLAY_WIDTH]);
+       uint8_t windows = planFlush();
+
+       for (uint8_t w = 0; w < windows; w++) {
+         const OLEDDISPLAY_WINDOW &window = flushWindows[w];
+
+         sendCommand(COLUMNADDR);
+         sendCommand(window.minX);
+         sendCommand(window.maxX);
+
+         sendCommand(PAGEADDR);
+         sendCommand(window.minPage);
+         sendCommand(window.maxPage);
+
+         digitalWrite(_cs, HIGH);
+         digitalWrite(_dc, HIGH);   // data mode
+         digitalWrite(_cs, LOW);
+         for (uint8_t y = window.minPage; y <= window.maxPage; y++) {
+           for (uint8_t x = window.minX; x <= window.maxX; x++) {
+             SPI.transfer(buffer[x + y * DISPLAY_WIDTH]);
+           }
+           yield();
          }
-         yield();
+         digitalWrite(_cs, HIGH);
        }
-       digitalWrite(_cs, HIGH);
-     #else
-       // No double buffering
-       sendCommand(COLUMNADDR);
-       sendCommand(0x0);
-       sendCommand(0x7F);
-
-       sendCommand(PAGEADDR);
-       sendCommand(0x0);
-       sendCommand(0x7);
-
-        digitalWrite(_cs, HIGH);
-        digitalWrite(_dc, HIGH);   // data mode
-        digitalWrite(_cs, LOW);
-        for (uint16_t i=0; i<DISPLAY_BUFFER_SIZE; i++) {
-          SPI.transfer(buffer[i]);
-          yield();
-        }
-        digitalWrite(_cs, HIGH);
-     #endif
     }
 
   private:
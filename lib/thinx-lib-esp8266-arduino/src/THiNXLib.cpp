@@ -18,12 +18,16 @@ extern "C" {
 #endif
 
 /* Debug tools (should be extradited from Release builds) */
+#ifdef ESP8266
 register uint32_t *sp asm("a1");
+#endif
 
 void printStackHeap(String tag) {
   uint32_t memfree = system_get_free_heap_size(); Serial.print(F("*TH: memfree = ")); Serial.println(memfree);
   Serial.printf("*TH: loop(): unmodified stack   = %4d\n", cont_get_free_stack(&g_cont));
+#ifdef ESP8266
   Serial.printf("*TH: loop(): current free stack = %4d\n", 4 * (sp - g_cont.stack));
+#endif
   Serial.print("*TH: loop(): heap = "); Serial.println(system_get_free_heap_size());
   Serial.print("*TH: loop(): tag = "); Serial.println(tag);
 }
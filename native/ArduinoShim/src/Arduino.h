@@ -0,0 +1,126 @@
+#ifndef Arduino_h
+#define Arduino_h
+
+// Host build of the Arduino/ESP8266 core API.
+//
+// Time comes from the monotonic clock, pins live in memory and analog
+// inputs are supplied by the program through NativeHost.h. Everything the
+// firmware and its libraries touch on the chip is emulated just far enough
+// for the code to build and run as a Linux process.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "pgmspace.h"
+#include "binary.h"
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <cmath>
+
+using std::min;
+using std::max;
+using std::abs;
+using std::isinf;
+using std::isnan;
+
+extern "C" {
+#endif
+
+typedef uint8_t boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#define HIGH            0x1
+#define LOW             0x0
+
+#define INPUT           0x00
+#define INPUT_PULLUP    0x02
+#define OUTPUT          0x01
+
+#define CHANGE          3
+#define FALLING         2
+#define RISING          1
+
+#define PI              3.1415926535897932384626433832795
+#define HALF_PI         1.5707963267948966192313216916398
+#define TWO_PI          6.283185307179586476925286766559
+#define DEG_TO_RAD      0.017453292519943295769236907684886
+#define RAD_TO_DEG      57.295779513082320876798154814105
+
+#define _min(a, b)      ((a) < (b) ? (a) : (b))
+#define _max(a, b)      ((a) > (b) ? (a) : (b))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x)           ((x) * (x))
+
+#define lowByte(w)      ((uint8_t) ((w) & 0xff))
+#define highByte(w)     ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit)   (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)    ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)  ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b)          (1UL << (b))
+
+// Code placement attributes have no meaning on the host
+#define ICACHE_RAM_ATTR
+#define ICACHE_FLASH_ATTR
+#define IRAM_ATTR
+
+#define interrupts()
+#define noInterrupts()
+#define ETS_UART_INTR_DISABLE()
+#define ETS_UART_INTR_ENABLE()
+
+// D1 mini pin map
+#define D0  16
+#define D1  5
+#define D2  4
+#define D3  0
+#define D4  2
+#define D5  14
+#define D6  12
+#define D7  13
+#define D8  15
+#define A0  17
+#define LED_BUILTIN 2
+
+#define NUM_DIGITAL_PINS 17
+#define NUM_ANALOG_INPUTS 1
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void analogWriteRange(uint32_t range);
+void analogWriteFreq(uint32_t freq);
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+void setup(void);
+void loop(void);
+
+#ifdef __cplusplus
+}
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+#include "WString.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+#endif
+
+#endif
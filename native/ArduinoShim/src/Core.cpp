@@ -0,0 +1,138 @@
+#include "Arduino.h"
+#include "NativeHost.h"
+#include "user_interface.h"
+#include "cont.h"
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NATIVE_PINS (A0 + 1)
+
+static int pins[NATIVE_PINS];
+static NativeAnalogSource analogSource = NULL;
+
+unsigned long nativeLoopCount = 0;
+
+static uint64_t monotonic_us() {
+  static uint64_t start = 0;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t now = (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+  if (!start) start = now;
+  return now - start;
+}
+
+extern "C" {
+
+unsigned long millis(void) {
+  return (unsigned long) (monotonic_us() / 1000);
+}
+
+unsigned long micros(void) {
+  return (unsigned long) monotonic_us();
+}
+
+void delay(unsigned long ms) {
+  usleep(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  usleep(us);
+}
+
+void yield(void) {
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void) pin;
+  (void) mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < NATIVE_PINS) pins[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < NATIVE_PINS ? (pins[pin] ? HIGH : LOW) : LOW;
+}
+
+int analogRead(uint8_t pin) {
+  return analogSource ? analogSource(pin) : 0;
+}
+
+void analogWrite(uint8_t pin, int value) {
+  if (pin < NATIVE_PINS) pins[pin] = value;
+}
+
+void analogWriteRange(uint32_t range) {
+  (void) range;
+}
+
+void analogWriteFreq(uint32_t freq) {
+  (void) freq;
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+  (void) pin;
+  (void) handler;
+  (void) mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  (void) pin;
+}
+
+uint32_t system_get_free_heap_size(void) {
+  return ESP.getFreeHeap();
+}
+
+uint32_t system_get_time(void) {
+  return (uint32_t) monotonic_us();
+}
+
+cont_t g_cont;
+
+int cont_get_free_stack(cont_t *cont) {
+  (void) cont;
+  return CONT_STACKSIZE;
+}
+
+}
+
+long random(long howbig) {
+  return howbig > 0 ? ::random() % howbig : 0;
+}
+
+long random(long howsmall, long howbig) {
+  return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  srandom(seed);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void nativeSetAnalogSource(NativeAnalogSource source) {
+  analogSource = source;
+}
+
+int nativePinValue(uint8_t pin) {
+  return pin < NATIVE_PINS ? pins[pin] : 0;
+}
+
+// Weak, so test programs can bring their own main()
+__attribute__((weak)) int main(int argc, char **argv) {
+  if (argc > 1) nativeLoopCount = strtoul(argv[1], NULL, 10);
+  setvbuf(stdout, NULL, _IOLBF, 0);
+
+  setup();
+  for (unsigned long i = 0; nativeLoopCount == 0 || i < nativeLoopCount; i++) {
+    loop();
+  }
+  fflush(stdout);
+  return 0;
+}
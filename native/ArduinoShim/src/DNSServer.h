@@ -0,0 +1,29 @@
+#ifndef DNSServer_h
+#define DNSServer_h
+
+#include "IPAddress.h"
+
+enum class DNSReplyCode {
+  NoError = 0,
+  FormError = 1,
+  ServerFailure = 2,
+  NonExistentDomain = 3,
+  NotImplemented = 4,
+  Refused = 5
+};
+
+// Captive portal DNS without a network, answers nothing
+
+class DNSServer {
+  public:
+    bool start(const uint16_t &port, const String &domainName, const IPAddress &resolvedIP) {
+      (void) port; (void) domainName; (void) resolvedIP;
+      return true;
+    }
+    void stop() {}
+    void processNextRequest() {}
+    void setErrorReplyCode(const DNSReplyCode &replyCode) { (void) replyCode; }
+    void setTTL(const uint32_t &ttl) { (void) ttl; }
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Emulated flash sector, kept in memory for the lifetime of the process
+
+class EEPROMClass {
+  public:
+    void begin(size_t size) { this->length = size < sizeof(this->data) ? size : sizeof(this->data); }
+    uint8_t read(int address) { return address >= 0 && (size_t) address < this->length ? this->data[address] : 0; }
+    void write(int address, uint8_t value) { if (address >= 0 && (size_t) address < this->length) this->data[address] = value; }
+    bool commit() { return true; }
+    void end() {}
+    uint8_t *getDataPtr() { return this->data; }
+
+    template <typename T>
+    T &get(int address, T &t) {
+      if (address >= 0 && address + sizeof(T) <= this->length) memcpy(&t, this->data + address, sizeof(T));
+      return t;
+    }
+
+    template <typename T>
+    const T &put(int address, const T &t) {
+      if (address >= 0 && address + sizeof(T) <= this->length) memcpy(this->data + address, &t, sizeof(T));
+      return t;
+    }
+
+  private:
+    uint8_t   data[4096];
+    size_t    length = 0;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef ESP8266HTTPClient_h
+#define ESP8266HTTPClient_h
+
+#include "ESP8266WiFi.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_STREAM           (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM        (-8)
+#define HTTPC_ERROR_ENCODING            (-9)
+#define HTTPC_ERROR_STREAM_WRITE        (-10)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+enum t_http_codes {
+  HTTP_CODE_OK = 200,
+  HTTP_CODE_NOT_FOUND = 404
+};
+
+// Every request fails as if the server could not be reached
+
+class HTTPClient {
+  public:
+    bool begin(String url) { (void) url; return true; }
+    bool begin(String host, uint16_t port, String uri = "/") { (void) host; (void) port; (void) uri; return true; }
+    bool begin(WiFiClient &client, String url) { (void) client; (void) url; return true; }
+    void end() {}
+    bool connected() { return false; }
+
+    void setReuse(bool reuse) { (void) reuse; }
+    void setUserAgent(const String &userAgent) { (void) userAgent; }
+    void setAuthorization(const char *user, const char *password) { (void) user; (void) password; }
+    void setTimeout(uint16_t timeout) { (void) timeout; }
+    void addHeader(const String &name, const String &value, bool first = false, bool replace = true) {
+      (void) name; (void) value; (void) first; (void) replace;
+    }
+
+    int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int POST(String payload) { (void) payload; return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int POST(uint8_t *payload, size_t size) { (void) payload; (void) size; return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int sendRequest(const char *type, String payload) { (void) type; (void) payload; return HTTPC_ERROR_CONNECTION_REFUSED; }
+
+    int getSize() { return -1; }
+    String getString() { return String(); }
+    static String errorToString(int error) { (void) error; return String("connection refused"); }
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef ESP8266WebServer_h
+#define ESP8266WebServer_h
+
+#include <functional>
+
+#include "ESP8266WiFi.h"
+
+// Web server that never receives a request, handlers are registered but
+// only run when the host program calls them
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+class ESP8266WebServer {
+  public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    ESP8266WebServer(int port = 80) { (void) port; }
+
+    void begin() {}
+    void close() {}
+    void stop() {}
+    void handleClient() {}
+
+    void on(const String &uri, THandlerFunction handler) { (void) uri; (void) handler; }
+    void on(const String &uri, HTTPMethod method, THandlerFunction handler) { (void) uri; (void) method; (void) handler; }
+    void onNotFound(THandlerFunction handler) { (void) handler; }
+
+    String uri() { return String(); }
+    HTTPMethod method() { return HTTP_GET; }
+    WiFiClient client() { return WiFiClient(); }
+
+    String arg(const String &name) { (void) name; return String(); }
+    String arg(int i) { (void) i; return String(); }
+    String argName(int i) { (void) i; return String(); }
+    int args() { return 0; }
+    bool hasArg(const String &name) { (void) name; return false; }
+    String hostHeader() { return String(); }
+
+    void send(int code, const char *content_type = NULL, const String &content = String()) { (void) code; (void) content_type; (void) content; }
+    void send(int code, const String &content_type, const String &content) { (void) code; (void) content_type; (void) content; }
+    void sendHeader(const String &name, const String &value, bool first = false) { (void) name; (void) value; (void) first; }
+};
+
+#endif
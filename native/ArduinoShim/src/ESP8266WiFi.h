@@ -0,0 +1,116 @@
+#ifndef ESP8266WiFi_h
+#define ESP8266WiFi_h
+
+#include "Arduino.h"
+#include "Client.h"
+#include "Server.h"
+#include "IPAddress.h"
+
+// The host network is simulated: the station joins whatever network it is
+// asked to right away, but every outgoing connection is refused. The
+// firmware runs its offline paths deterministically.
+
+enum WiFiMode {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+};
+typedef WiFiMode WiFiMode_t;
+
+typedef enum {
+  WL_NO_SHIELD        = 255,
+  WL_IDLE_STATUS      = 0,
+  WL_NO_SSID_AVAIL    = 1,
+  WL_SCAN_COMPLETED   = 2,
+  WL_CONNECTED        = 3,
+  WL_CONNECT_FAILED   = 4,
+  WL_CONNECTION_LOST  = 5,
+  WL_DISCONNECTED     = 6
+} wl_status_t;
+
+enum wl_enc_type {
+  ENC_TYPE_WEP  = 5,
+  ENC_TYPE_TKIP = 2,
+  ENC_TYPE_CCMP = 4,
+  ENC_TYPE_NONE = 7,
+  ENC_TYPE_AUTO = 8
+};
+
+class ESP8266WiFiClass {
+  public:
+    bool mode(WiFiMode_t mode) { this->currentMode = mode; return true; }
+    WiFiMode_t getMode() { return this->currentMode; }
+
+    wl_status_t begin(const char *ssid, const char *passphrase = NULL, int32_t channel = 0, const uint8_t *bssid = NULL, bool connect = true);
+    wl_status_t begin();
+    bool config(IPAddress local_ip, IPAddress gateway, IPAddress subnet) { (void) local_ip; (void) gateway; (void) subnet; return true; }
+    bool disconnect(bool wifioff = false);
+    bool setAutoConnect(bool autoConnect) { (void) autoConnect; return true; }
+    bool setAutoReconnect(bool autoReconnect) { (void) autoReconnect; return true; }
+    uint8_t waitForConnectResult() { return this->status(); }
+    bool beginWPSConfig() { return false; }
+    bool hostname(const char *name) { (void) name; return true; }
+
+    wl_status_t status() { return this->currentStatus; }
+    String SSID() const { return this->ssid; }
+    String psk() const { return this->passphrase; }
+    int32_t RSSI() { return this->currentStatus == WL_CONNECTED ? -60 : 0; }
+    IPAddress localIP() { return this->currentStatus == WL_CONNECTED ? IPAddress(192, 168, 1, 100) : IPAddress(); }
+    String macAddress() { return "5C:CF:7F:C0:FF:EE"; }
+    uint8_t *macAddress(uint8_t *mac);
+
+    bool softAP(const char *ssid, const char *passphrase = NULL, int channel = 1, int ssid_hidden = 0);
+    bool softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet) { (void) gateway; (void) subnet; this->apIP = local_ip; return true; }
+    bool softAPdisconnect(bool wifioff = false) { (void) wifioff; return true; }
+    IPAddress softAPIP() { return this->apIP; }
+    String softAPmacAddress() { return "5E:CF:7F:C0:FF:EE"; }
+
+    // No networks around
+    int8_t scanNetworks(bool async = false, bool show_hidden = false) { (void) async; (void) show_hidden; return 0; }
+    String SSID(uint8_t networkItem) { (void) networkItem; return String(); }
+    int32_t RSSI(uint8_t networkItem) { (void) networkItem; return 0; }
+    uint8_t encryptionType(uint8_t networkItem) { (void) networkItem; return ENC_TYPE_NONE; }
+
+  private:
+    WiFiMode_t    currentMode   = WIFI_STA;
+    wl_status_t   currentStatus = WL_DISCONNECTED;
+    String        ssid;
+    String        passphrase;
+    IPAddress     apIP          = IPAddress(192, 168, 4, 1);
+};
+
+extern ESP8266WiFiClass WiFi;
+
+class WiFiClient : public Client {
+  public:
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char *host, uint16_t port) override;
+    size_t write(uint8_t c) override { (void) c; return 0; }
+    size_t write(const uint8_t *buf, size_t size) override { (void) buf; (void) size; return 0; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int read(uint8_t *buf, size_t size) override { (void) buf; (void) size; return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+    void stop() override {}
+    uint8_t connected() override { return 0; }
+    operator bool() override { return false; }
+
+    void setNoDelay(bool nodelay) { (void) nodelay; }
+    IPAddress remoteIP() { return IPAddress(); }
+    IPAddress localIP() { return WiFi.localIP(); }
+};
+
+class WiFiServer : public Server {
+  public:
+    WiFiServer(uint16_t port) { (void) port; }
+    void begin() override {}
+    void close() {}
+    WiFiClient available() { return WiFiClient(); }
+    size_t write(uint8_t c) override { (void) c; return 0; }
+    using Print::write;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef ESP8266httpUpdate_h
+#define ESP8266httpUpdate_h
+
+#include "ESP8266HTTPClient.h"
+
+enum HTTPUpdateResult {
+  HTTP_UPDATE_FAILED,
+  HTTP_UPDATE_NO_UPDATES,
+  HTTP_UPDATE_OK
+};
+typedef HTTPUpdateResult t_httpUpdate_return;
+
+// Firmware images cannot be fetched, updates always fail
+
+class ESP8266HTTPUpdate {
+  public:
+    t_httpUpdate_return update(const String &url, const String &currentVersion = "") {
+      (void) url; (void) currentVersion;
+      return HTTP_UPDATE_FAILED;
+    }
+    t_httpUpdate_return update(const String &host, uint16_t port, const String &uri = "/", const String &currentVersion = "") {
+      (void) host; (void) port; (void) uri; (void) currentVersion;
+      return HTTP_UPDATE_FAILED;
+    }
+    void rebootOnUpdate(bool reboot) { (void) reboot; }
+    int getLastError() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    String getLastErrorString() { return HTTPClient::errorToString(this->getLastError()); }
+};
+
+extern ESP8266HTTPUpdate ESPhttpUpdate;
+
+#endif
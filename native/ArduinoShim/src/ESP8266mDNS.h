@@ -0,0 +1,22 @@
+#ifndef ESP8266mDNS_h
+#define ESP8266mDNS_h
+
+#include "ESP8266WiFi.h"
+
+// mDNS responder without peers, queries find no services
+
+class MDNSResponder {
+  public:
+    bool begin(const char *hostName) { (void) hostName; return true; }
+    void update() {}
+    void addService(const char *service, const char *proto, uint16_t port) { (void) service; (void) proto; (void) port; }
+
+    int queryService(const char *service, const char *proto) { (void) service; (void) proto; return 0; }
+    String hostname(int idx) { (void) idx; return String(); }
+    IPAddress IP(int idx) { (void) idx; return IPAddress(); }
+    uint16_t port(int idx) { (void) idx; return 0; }
+};
+
+extern MDNSResponder MDNS;
+
+#endif
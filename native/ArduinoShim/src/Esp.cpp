@@ -0,0 +1,45 @@
+#include "Arduino.h"
+#include "ESP8266mDNS.h"
+#include "ESP8266httpUpdate.h"
+#include "EEPROM.h"
+
+#include <stdio.h>
+
+EspClass ESP;
+MDNSResponder MDNS;
+ESP8266HTTPUpdate ESPhttpUpdate;
+EEPROMClass EEPROM;
+
+void EspClass::reset() {
+  this->restart();
+}
+
+void EspClass::restart() {
+  fflush(stdout);
+  fprintf(stderr, "native: restart requested, exiting\n");
+  exit(0);
+}
+
+void EspClass::deepSleep(uint64_t time_us) {
+  (void) time_us;
+  fflush(stdout);
+  fprintf(stderr, "native: deep sleep requested, exiting\n");
+  exit(0);
+}
+
+uint32_t EspClass::getFreeHeap() {
+  // Typical free heap of the firmware after boot
+  return 40 * 1024;
+}
+
+uint32_t EspClass::getCycleCount() {
+  return (uint32_t) (micros() * 80);
+}
+
+bool EspClass::updateSketch(Stream &in, uint32_t size, bool restartOnFail, bool restartOnSuccess) {
+  (void) in;
+  (void) size;
+  (void) restartOnSuccess;
+  if (restartOnFail) this->restart();
+  return false;
+}
@@ -0,0 +1,59 @@
+#ifndef Esp_h
+#define Esp_h
+
+#include <stdint.h>
+
+#include "WString.h"
+
+class Stream;
+
+enum WDTO_t {
+  WDTO_0MS    = 0,
+  WDTO_15MS   = 15,
+  WDTO_30MS   = 30,
+  WDTO_60MS   = 60,
+  WDTO_120MS  = 120,
+  WDTO_250MS  = 250,
+  WDTO_500MS  = 500,
+  WDTO_1S     = 1000,
+  WDTO_2S     = 2000,
+  WDTO_4S     = 4000,
+  WDTO_8S     = 8000
+};
+
+#define wdt_enable(time)  ESP.wdtEnable(time)
+#define wdt_disable()     ESP.wdtDisable()
+#define wdt_reset()       ESP.wdtFeed()
+
+class EspClass {
+  public:
+    void wdtEnable(uint32_t timeout_ms = 0) { (void) timeout_ms; }
+    void wdtDisable() {}
+    void wdtFeed() {}
+
+    // The host has no reset, restarting ends the process
+    void reset() __attribute__ ((noreturn));
+    void restart() __attribute__ ((noreturn));
+    void deepSleep(uint64_t time_us) __attribute__ ((noreturn));
+
+    uint32_t getChipId() { return 0x00C0FFEE; }
+    uint32_t getFlashChipId() { return 0x001640E0; }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    uint32_t getFlashChipRealSize() { return 4 * 1024 * 1024; }
+    uint32_t getFreeHeap();
+    uint32_t getSketchSize() { return 0; }
+    uint32_t getFreeSketchSpace() { return 1024 * 1024; }
+    uint8_t getCpuFreqMHz() { return 80; }
+    String getResetReason() { return "Power on"; }
+    const char *getSdkVersion() { return "native"; }
+
+    // Cycle counter of an 80 MHz core
+    uint32_t getCycleCount();
+
+    // Firmware updates are refused on the host
+    bool updateSketch(Stream &in, uint32_t size, bool restartOnFail = false, bool restartOnSuccess = true);
+};
+
+extern EspClass ESP;
+
+#endif
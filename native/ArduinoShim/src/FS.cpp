@@ -0,0 +1,117 @@
+#include "FS.h"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+fs::FS SPIFFS;
+
+namespace fs {
+
+size_t File::write(uint8_t c) {
+  return this->write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buf, size_t size) {
+  return this->file ? fwrite(buf, 1, size, this->file) : 0;
+}
+
+int File::available() {
+  if (!this->file) return 0;
+  return this->size() - this->position();
+}
+
+int File::read() {
+  return this->file ? fgetc(this->file) : -1;
+}
+
+int File::peek() {
+  if (!this->file) return -1;
+  int c = fgetc(this->file);
+  if (c != EOF) ungetc(c, this->file);
+  return c;
+}
+
+void File::flush() {
+  if (this->file) fflush(this->file);
+}
+
+size_t File::read(uint8_t *buf, size_t size) {
+  return this->file ? fread(buf, 1, size, this->file) : 0;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  static const int whence[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+  return this->file && fseek(this->file, pos, whence[mode]) == 0;
+}
+
+size_t File::position() const {
+  return this->file ? ftell(this->file) : 0;
+}
+
+size_t File::size() const {
+  if (!this->file) return 0;
+  struct stat st;
+  fflush(this->file);
+  return fstat(fileno(this->file), &st) == 0 ? st.st_size : 0;
+}
+
+void File::close() {
+  if (this->file) fclose(this->file);
+  this->file = NULL;
+}
+
+String FS::root() {
+  const char *dir = getenv("SPIFFS_DIR");
+  return String(dir && *dir ? dir : "/tmp/native-spiffs");
+}
+
+bool FS::begin() {
+  String dir = this->root();
+  mkdir(dir.c_str(), 0755);
+  struct stat st;
+  return stat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool FS::format() {
+  String dir = this->root();
+  DIR *d = opendir(dir.c_str());
+  if (d) {
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL) {
+      if (entry->d_type == DT_REG) unlink((dir + "/" + entry->d_name).c_str());
+    }
+    closedir(d);
+  }
+  return this->begin();
+}
+
+// SPIFFS has a flat namespace, nested paths map onto a single file name
+static String flatten(const char *path) {
+  String name(path);
+  if (name.startsWith("/")) name.remove(0, 1);
+  name.replace('/', '_');
+  return name;
+}
+
+File FS::open(const char *path, const char *mode) {
+  String full = this->root() + "/" + flatten(path);
+  FILE *file = fopen(full.c_str(), mode);
+  return File(file, path);
+}
+
+bool FS::exists(const char *path) {
+  struct stat st;
+  return stat((this->root() + "/" + flatten(path)).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path) {
+  return unlink((this->root() + "/" + flatten(path)).c_str()) == 0;
+}
+
+bool FS::rename(const char *pathFrom, const char *pathTo) {
+  return ::rename((this->root() + "/" + flatten(pathFrom)).c_str(), (this->root() + "/" + flatten(pathTo)).c_str()) == 0;
+}
+
+}
@@ -0,0 +1,69 @@
+#ifndef FS_h
+#define FS_h
+
+#include <stdio.h>
+
+#include "Arduino.h"
+
+// SPIFFS on top of a host directory, $SPIFFS_DIR or a directory below /tmp
+
+namespace fs {
+
+enum SeekMode {
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+class File : public Stream {
+  public:
+    File(FILE *file = NULL, const String &name = String()) : file(file), path(name) {}
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    size_t read(uint8_t *buf, size_t size);
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    const char *name() const { return this->path.c_str(); }
+    operator bool() const { return this->file != NULL; }
+
+  private:
+    FILE    *file;
+    String  path;
+};
+
+class FS {
+  public:
+    bool begin();
+    void end() {}
+    bool format();
+    File open(const char *path, const char *mode);
+    File open(const String &path, const char *mode) { return this->open(path.c_str(), mode); }
+    bool exists(const char *path);
+    bool exists(const String &path) { return this->exists(path.c_str()); }
+    bool remove(const char *path);
+    bool rename(const char *pathFrom, const char *pathTo);
+
+  private:
+    String root();
+};
+
+}
+
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+extern fs::FS SPIFFS;
+
+#endif
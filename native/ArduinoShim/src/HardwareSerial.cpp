@@ -0,0 +1,41 @@
+#include "HardwareSerial.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+
+int HardwareSerial::available() {
+  return this->peek() >= 0 ? 1 : 0;
+}
+
+int HardwareSerial::read() {
+  int c = this->peek();
+  this->peeked = -1;
+  return c;
+}
+
+int HardwareSerial::peek() {
+  if (this->peeked >= 0) return this->peeked;
+
+  // Non-blocking, the firmware polls the port from loop()
+  int flags = fcntl(STDIN_FILENO, F_GETFL);
+  fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
+  unsigned char c;
+  if (::read(STDIN_FILENO, &c, 1) == 1) this->peeked = c;
+  fcntl(STDIN_FILENO, F_SETFL, flags);
+  return this->peeked;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() {
+  fflush(stdout);
+}
@@ -0,0 +1,31 @@
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include "Stream.h"
+
+// Serial port mapped onto the process' stdin/stdout
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud) { (void) baud; }
+    void end() {}
+    void setDebugOutput(bool enable) { (void) enable; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    operator bool() const { return true; }
+
+  private:
+    int peeked = -1;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,25 @@
+#include "IPAddress.h"
+#include "Print.h"
+
+#include <stdio.h>
+
+const IPAddress INADDR_NONE(0, 0, 0, 0);
+
+bool IPAddress::fromString(const char *address) {
+  unsigned int a, b, c, d;
+  char tail;
+  if (sscanf(address, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4) return false;
+  if (a > 255 || b > 255 || c > 255 || d > 255) return false;
+  *this = IPAddress(a, b, c, d);
+  return true;
+}
+
+String IPAddress::toString() const {
+  char text[16];
+  snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+  return String(text);
+}
+
+size_t IPAddress::printTo(Print &p) const {
+  return p.print(this->toString());
+}
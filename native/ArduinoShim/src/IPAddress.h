@@ -0,0 +1,41 @@
+#ifndef IPAddress_h
+#define IPAddress_h
+
+#include <stdint.h>
+
+#include "Printable.h"
+#include "WString.h"
+
+class IPAddress : public Printable {
+  public:
+    IPAddress() { this->address.dword = 0; }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+      this->address.bytes[0] = a;
+      this->address.bytes[1] = b;
+      this->address.bytes[2] = c;
+      this->address.bytes[3] = d;
+    }
+    IPAddress(uint32_t address) { this->address.dword = address; }
+
+    operator uint32_t() const { return this->address.dword; }
+    bool operator==(const IPAddress &other) const { return this->address.dword == other.address.dword; }
+    bool operator!=(const IPAddress &other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return this->address.bytes[index]; }
+    uint8_t &operator[](int index) { return this->address.bytes[index]; }
+
+    bool fromString(const char *address);
+    bool fromString(const String &address) { return this->fromString(address.c_str()); }
+    String toString() const;
+
+    size_t printTo(Print &p) const override;
+
+  private:
+    union {
+      uint8_t   bytes[4];
+      uint32_t  dword;
+    } address;
+};
+
+extern const IPAddress INADDR_NONE;
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef NativeHost_h
+#define NativeHost_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Hooks for driving the firmware from the host side: feed analog inputs,
+// watch the buses and read back pin state. Only available in the native
+// build.
+
+typedef int (*NativeAnalogSource)(uint8_t pin);
+typedef void (*NativeI2CListener)(uint8_t address, const uint8_t *data, size_t length);
+typedef void (*NativeSPIListener)(uint8_t data);
+
+struct NativeBusStats {
+  uint32_t  transactions;   // I2C transmissions, SPI transfers
+  uint32_t  bytes;          // payload bytes including the address/control byte
+};
+
+// Supplies analogRead(), the default source reads 0
+void nativeSetAnalogSource(NativeAnalogSource source);
+
+void nativeSetI2CListener(NativeI2CListener listener);
+void nativeSetSPIListener(NativeSPIListener listener);
+
+const NativeBusStats &nativeI2CStats();
+const NativeBusStats &nativeSPIStats();
+void nativeResetI2CStats();
+void nativeResetSPIStats();
+
+// Level or PWM duty last written to a pin
+int nativePinValue(uint8_t pin);
+
+// Number of loop() calls after setup(), 0 runs forever. Set by the first
+// command line argument.
+extern unsigned long nativeLoopCount;
+
+#endif
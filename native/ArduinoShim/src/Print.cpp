@@ -0,0 +1,42 @@
+#include "Print.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    n += this->write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+  va_list arg;
+  va_start(arg, format);
+  char temp[64];
+  int len = vsnprintf(temp, sizeof(temp), format, arg);
+  va_end(arg);
+  if (len < 0) return 0;
+  if ((size_t) len < sizeof(temp)) return this->write((const uint8_t *) temp, len);
+
+  std::string buffer(len + 1, 0);
+  va_start(arg, format);
+  vsnprintf(&buffer[0], len + 1, format, arg);
+  va_end(arg);
+  return this->write((const uint8_t *) buffer.data(), len);
+}
+
+size_t Print::print(long value, int base) {
+  if (base == 0) return this->write((uint8_t) value);
+  return this->print(String(value, (unsigned char) base));
+}
+
+size_t Print::print(unsigned long value, int base) {
+  if (base == 0) return this->write((uint8_t) value);
+  return this->print(String(value, (unsigned char) base));
+}
+
+size_t Print::print(double value, int digits) {
+  return this->print(String(value, (unsigned char) digits));
+}
@@ -0,0 +1,46 @@
+#ifndef Print_h
+#define Print_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "WString.h"
+#include "Printable.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return str ? this->write((const uint8_t *) str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return this->write((const uint8_t *) buffer, size); }
+    virtual void flush() {}
+
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+
+    size_t print(const __FlashStringHelper *str) { return this->write((const char *) str); }
+    size_t print(const String &str) { return this->write(str.c_str(), str.length()); }
+    size_t print(const char *str) { return this->write(str); }
+    size_t print(char c) { return this->write((uint8_t) c); }
+    size_t print(unsigned char value, int base = DEC) { return this->print((unsigned long) value, base); }
+    size_t print(int value, int base = DEC) { return this->print((long) value, base); }
+    size_t print(unsigned int value, int base = DEC) { return this->print((unsigned long) value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+    size_t print(const Printable &p) { return p.printTo(*this); }
+
+    size_t println() { return this->write("\r\n"); }
+    template <typename T>
+    size_t println(const T &value) { size_t n = this->print(value); return n + this->println(); }
+    template <typename T>
+    size_t println(const T &value, int format) { size_t n = this->print(value, format); return n + this->println(); }
+};
+
+#endif
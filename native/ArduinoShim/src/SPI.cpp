@@ -0,0 +1,30 @@
+#include "SPI.h"
+#include "NativeHost.h"
+
+SPIClass SPI;
+
+static NativeSPIListener spiListener = NULL;
+static NativeBusStats spiStats;
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  spiStats.transactions++;
+  spiStats.bytes++;
+  if (spiListener) spiListener(data);
+  return 0xff;
+}
+
+void SPIClass::writeBytes(const uint8_t *data, uint32_t size) {
+  while (size--) this->transfer(*data++);
+}
+
+void nativeSetSPIListener(NativeSPIListener listener) {
+  spiListener = listener;
+}
+
+const NativeBusStats &nativeSPIStats() {
+  return spiStats;
+}
+
+void nativeResetSPIStats() {
+  spiStats = NativeBusStats();
+}
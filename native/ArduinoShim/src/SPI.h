@@ -0,0 +1,46 @@
+#ifndef SPI_h
+#define SPI_h
+
+#include "Arduino.h"
+
+#define SPI_CLOCK_DIV2    0x00101001
+#define SPI_CLOCK_DIV4    0x00241001
+#define SPI_CLOCK_DIV8    0x004c1001
+#define SPI_CLOCK_DIV16   0x009c1001
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x10
+#define SPI_MODE3 0x11
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+class SPISettings {
+  public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0) {
+      (void) clock; (void) bitOrder; (void) dataMode;
+    }
+};
+
+// SPI master, every byte goes to the listener set through NativeHost.h and
+// reads back as 0xff
+
+class SPIClass {
+  public:
+    void begin() {}
+    void end() {}
+    void setClockDivider(uint32_t divider) { (void) divider; }
+    void setFrequency(uint32_t frequency) { (void) frequency; }
+    void setDataMode(uint8_t mode) { (void) mode; }
+    void setBitOrder(uint8_t order) { (void) order; }
+    void beginTransaction(SPISettings settings) { (void) settings; }
+    void endTransaction() {}
+
+    uint8_t transfer(uint8_t data);
+    void writeBytes(const uint8_t *data, uint32_t size);
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef Server_h
+#define Server_h
+
+#include "Print.h"
+
+class Server : public Print {
+  public:
+    virtual void begin() = 0;
+};
+
+#endif
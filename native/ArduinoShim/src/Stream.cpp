@@ -0,0 +1,52 @@
+#include "Arduino.h"
+#include "Stream.h"
+
+int Stream::timedRead() {
+  unsigned long start = millis();
+  do {
+    int c = this->read();
+    if (c >= 0) return c;
+    yield();
+  } while (millis() - start < this->timeout);
+  return -1;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    int c = this->timedRead();
+    if (c < 0) break;
+    *buffer++ = (char) c;
+    count++;
+  }
+  return count;
+}
+
+String Stream::readString() {
+  String out;
+  int c;
+  while ((c = this->timedRead()) >= 0) {
+    out += (char) c;
+  }
+  return out;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String out;
+  int c;
+  while ((c = this->timedRead()) >= 0 && c != terminator) {
+    out += (char) c;
+  }
+  return out;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    int c = this->timedRead();
+    if (c < 0 || c == terminator) break;
+    *buffer++ = (char) c;
+    count++;
+  }
+  return count;
+}
@@ -0,0 +1,26 @@
+#ifndef Stream_h
+#define Stream_h
+
+#include "Print.h"
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { this->timeout = timeout; }
+
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return this->readBytes((char *) buffer, length); }
+    String readString();
+    String readStringUntil(char terminator);
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+
+  protected:
+    unsigned long timeout = 1000;
+
+    int timedRead();
+};
+
+#endif
@@ -0,0 +1,169 @@
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <strings.h>
+
+static std::string format_unsigned(unsigned long value, unsigned char base) {
+  if (base < 2 || base > 36) base = 10;
+  char buf[8 * sizeof(value) + 1];
+  char *p = buf + sizeof(buf) - 1;
+  *p = 0;
+  do {
+    unsigned digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= base;
+  } while (value);
+  return p;
+}
+
+static std::string format_signed(long value, unsigned char base) {
+  if (base == 10 && value < 0) return "-" + format_unsigned(-(unsigned long) value, base);
+  return format_unsigned((unsigned long) value, base);
+}
+
+static std::string format_double(double value, unsigned char decimalPlaces) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+  return buf;
+}
+
+String::String(const char *cstr) : s(cstr ? cstr : "") {}
+String::String(const __FlashStringHelper *str) : s(str ? (const char *) str : "") {}
+String::String(char c) : s(1, c) {}
+String::String(unsigned char value, unsigned char base) : s(format_unsigned(value, base)) {}
+String::String(int value, unsigned char base) : s(format_signed(value, base)) {}
+String::String(unsigned int value, unsigned char base) : s(format_unsigned(value, base)) {}
+String::String(long value, unsigned char base) : s(format_signed(value, base)) {}
+String::String(unsigned long value, unsigned char base) : s(format_unsigned(value, base)) {}
+String::String(float value, unsigned char decimalPlaces) : s(format_double(value, decimalPlaces)) {}
+String::String(double value, unsigned char decimalPlaces) : s(format_double(value, decimalPlaces)) {}
+
+String &String::operator=(const __FlashStringHelper *str) {
+  this->s = str ? (const char *) str : "";
+  return *this;
+}
+
+unsigned char String::concat(const __FlashStringHelper *str) {
+  if (str) this->s += (const char *) str;
+  return 1;
+}
+
+unsigned char String::equalsIgnoreCase(const String &str) const {
+  return this->s.length() == str.s.length() && strcasecmp(this->c_str(), str.c_str()) == 0;
+}
+
+unsigned char String::startsWith(const String &prefix, unsigned int offset) const {
+  if (offset > this->s.length()) return 0;
+  return this->s.compare(offset, prefix.s.length(), prefix.s) == 0;
+}
+
+unsigned char String::endsWith(const String &suffix) const {
+  if (suffix.s.length() > this->s.length()) return 0;
+  return this->s.compare(this->s.length() - suffix.s.length(), suffix.s.length(), suffix.s) == 0;
+}
+
+char &String::operator[](unsigned int index) {
+  static char dummy;
+  if (index >= this->s.length()) {
+    dummy = 0;
+    return dummy;
+  }
+  return this->s[index];
+}
+
+void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index) const {
+  if (!bufsize || !buf) return;
+  if (index >= this->s.length()) {
+    buf[0] = 0;
+    return;
+  }
+  unsigned int n = this->s.copy((char *) buf, bufsize - 1, index);
+  buf[n] = 0;
+}
+
+static int found(size_t pos) {
+  return pos == std::string::npos ? -1 : (int) pos;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+  return found(this->s.find(ch, fromIndex));
+}
+
+int String::indexOf(const String &str, unsigned int fromIndex) const {
+  return found(this->s.find(str.s, fromIndex));
+}
+
+int String::lastIndexOf(char ch) const {
+  return found(this->s.rfind(ch));
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const {
+  return found(this->s.rfind(ch, fromIndex));
+}
+
+int String::lastIndexOf(const String &str) const {
+  return found(this->s.rfind(str.s));
+}
+
+int String::lastIndexOf(const String &str, unsigned int fromIndex) const {
+  return found(this->s.rfind(str.s, fromIndex));
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+  if (beginIndex > endIndex) {
+    unsigned int t = beginIndex;
+    beginIndex = endIndex;
+    endIndex = t;
+  }
+  if (beginIndex >= this->s.length()) return String();
+  String out;
+  out.s = this->s.substr(beginIndex, endIndex - beginIndex);
+  return out;
+}
+
+void String::replace(char find, char replace) {
+  for (size_t i = 0; i < this->s.length(); i++) {
+    if (this->s[i] == find) this->s[i] = replace;
+  }
+}
+
+void String::replace(const String &find, const String &replace) {
+  if (find.s.empty()) return;
+  size_t pos = 0;
+  while ((pos = this->s.find(find.s, pos)) != std::string::npos) {
+    this->s.replace(pos, find.s.length(), replace.s);
+    pos += replace.s.length();
+  }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= this->s.length()) return;
+  this->s.erase(index, count);
+}
+
+void String::toLowerCase() {
+  for (size_t i = 0; i < this->s.length(); i++) this->s[i] = tolower((unsigned char) this->s[i]);
+}
+
+void String::toUpperCase() {
+  for (size_t i = 0; i < this->s.length(); i++) this->s[i] = toupper((unsigned char) this->s[i]);
+}
+
+void String::trim() {
+  size_t begin = this->s.find_first_not_of(" \t\r\n\f\v");
+  if (begin == std::string::npos) {
+    this->s.clear();
+    return;
+  }
+  size_t end = this->s.find_last_not_of(" \t\r\n\f\v");
+  this->s = this->s.substr(begin, end - begin + 1);
+}
+
+long String::toInt() const {
+  return atol(this->c_str());
+}
+
+float String::toFloat() const {
+  return atof(this->c_str());
+}
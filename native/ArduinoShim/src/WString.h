@@ -0,0 +1,131 @@
+#ifndef WString_h
+#define WString_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+#include "pgmspace.h"
+
+// Arduino String on top of std::string, enough of the API for the firmware
+// and its libraries
+
+class __FlashStringHelper;
+#define FPSTR(p)  (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s)      FPSTR(PSTR(s))
+
+class String {
+  public:
+    String(const char *cstr = "");
+    String(const String &str) : s(str.s) {}
+    String(const __FlashStringHelper *str);
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned char decimalPlaces = 2);
+    explicit String(double value, unsigned char decimalPlaces = 2);
+
+    String &operator=(const String &rhs) { this->s = rhs.s; return *this; }
+    String &operator=(const char *cstr) { this->s = cstr ? cstr : ""; return *this; }
+    String &operator=(const __FlashStringHelper *str);
+
+    unsigned char reserve(unsigned int size) { this->s.reserve(size); return 1; }
+    unsigned int length() const { return this->s.length(); }
+    const char *c_str() const { return this->s.c_str(); }
+
+    // Arduino strings only turn false when an allocation failed
+    explicit operator bool() const { return true; }
+
+    unsigned char concat(const String &str) { this->s += str.s; return 1; }
+    unsigned char concat(const char *cstr) { if (cstr) this->s += cstr; return 1; }
+    unsigned char concat(const __FlashStringHelper *str);
+    unsigned char concat(char c) { this->s += c; return 1; }
+    unsigned char concat(unsigned char value) { return this->concat(String(value)); }
+    unsigned char concat(int value) { return this->concat(String(value)); }
+    unsigned char concat(unsigned int value) { return this->concat(String(value)); }
+    unsigned char concat(long value) { return this->concat(String(value)); }
+    unsigned char concat(unsigned long value) { return this->concat(String(value)); }
+    unsigned char concat(float value) { return this->concat(String(value)); }
+    unsigned char concat(double value) { return this->concat(String(value)); }
+
+    template <typename T>
+    String &operator+=(const T &rhs) { this->concat(rhs); return *this; }
+
+    int compareTo(const String &str) const { return this->s.compare(str.s); }
+    unsigned char equals(const String &str) const { return this->s == str.s; }
+    unsigned char equals(const char *cstr) const { return this->s == (cstr ? cstr : ""); }
+    unsigned char equalsIgnoreCase(const String &str) const;
+    unsigned char startsWith(const String &prefix) const { return this->s.compare(0, prefix.s.length(), prefix.s) == 0; }
+    unsigned char startsWith(const String &prefix, unsigned int offset) const;
+    unsigned char endsWith(const String &suffix) const;
+
+    unsigned char operator==(const String &rhs) const { return this->equals(rhs); }
+    unsigned char operator==(const char *cstr) const { return this->equals(cstr); }
+    unsigned char operator!=(const String &rhs) const { return !this->equals(rhs); }
+    unsigned char operator!=(const char *cstr) const { return !this->equals(cstr); }
+    unsigned char operator<(const String &rhs) const { return this->compareTo(rhs) < 0; }
+    unsigned char operator>(const String &rhs) const { return this->compareTo(rhs) > 0; }
+
+    char charAt(unsigned int index) const { return index < this->s.length() ? this->s[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < this->s.length()) this->s[index] = c; }
+    char operator[](unsigned int index) const { return this->charAt(index); }
+    char &operator[](unsigned int index);
+    void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const;
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const {
+      this->getBytes((unsigned char *) buf, bufsize, index);
+    }
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const;
+    int indexOf(const String &str, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(char ch, unsigned int fromIndex) const;
+    int lastIndexOf(const String &str) const;
+    int lastIndexOf(const String &str, unsigned int fromIndex) const;
+
+    String substring(unsigned int beginIndex) const { return this->substring(beginIndex, this->s.length()); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void replace(char find, char replace);
+    void replace(const String &find, const String &replace);
+    void remove(unsigned int index) { this->remove(index, (unsigned int) -1); }
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const;
+    float toFloat() const;
+
+  private:
+    std::string s;
+};
+
+class StringSumHelper : public String {
+  public:
+    StringSumHelper(const String &s) : String(s) {}
+    StringSumHelper(const char *p) : String(p) {}
+};
+
+template <typename T>
+StringSumHelper operator+(const StringSumHelper &lhs, const T &rhs) {
+  StringSumHelper result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+inline StringSumHelper operator+(const String &lhs, const String &rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, const char *rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const char *lhs, const String &rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, const __FlashStringHelper *rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, char rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, int rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, unsigned int rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, long rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, unsigned long rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, float rhs) { return StringSumHelper(lhs) + rhs; }
+inline StringSumHelper operator+(const String &lhs, double rhs) { return StringSumHelper(lhs) + rhs; }
+
+#endif
@@ -0,0 +1,67 @@
+#include "ESP8266WiFi.h"
+#include "user_interface.h"
+
+ESP8266WiFiClass WiFi;
+
+wl_status_t ESP8266WiFiClass::begin(const char *ssid, const char *passphrase, int32_t channel, const uint8_t *bssid, bool connect) {
+  (void) channel;
+  (void) bssid;
+  this->ssid = ssid ? ssid : "";
+  this->passphrase = passphrase ? passphrase : "";
+  if (connect) return this->begin();
+  return this->currentStatus;
+}
+
+wl_status_t ESP8266WiFiClass::begin() {
+  if (this->ssid.length() == 0 || !(this->currentMode & WIFI_STA)) {
+    this->currentStatus = WL_NO_SSID_AVAIL;
+  } else {
+    this->currentStatus = WL_CONNECTED;
+  }
+  return this->currentStatus;
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifioff) {
+  (void) wifioff;
+  this->currentStatus = WL_DISCONNECTED;
+  return true;
+}
+
+uint8_t *ESP8266WiFiClass::macAddress(uint8_t *mac) {
+  static const uint8_t address[6] = { 0x5C, 0xCF, 0x7F, 0xC0, 0xFF, 0xEE };
+  memcpy(mac, address, sizeof(address));
+  return mac;
+}
+
+bool ESP8266WiFiClass::softAP(const char *ssid, const char *passphrase, int channel, int ssid_hidden) {
+  (void) ssid;
+  (void) passphrase;
+  (void) channel;
+  (void) ssid_hidden;
+  return true;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+  (void) ip;
+  (void) port;
+  return 0;
+}
+
+int WiFiClient::connect(const char *host, uint16_t port) {
+  (void) host;
+  (void) port;
+  return 0;
+}
+
+extern "C" {
+
+uint8_t wifi_softap_get_station_num(void) {
+  return 0;
+}
+
+bool wifi_station_disconnect(void) {
+  WiFi.disconnect();
+  return true;
+}
+
+}
@@ -0,0 +1,48 @@
+#include "Wire.h"
+#include "NativeHost.h"
+
+TwoWire Wire;
+
+static NativeI2CListener i2cListener = NULL;
+static NativeBusStats i2cStats;
+
+void TwoWire::beginTransmission(uint8_t address) {
+  this->address = address;
+  this->length = 0;
+  this->transmitting = true;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (!this->transmitting || this->length >= BUFFER_LENGTH) return 0;
+  this->buffer[this->length++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  size_t n = 0;
+  while (n < quantity && this->write(data[n])) n++;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+  (void) sendStop;
+  if (!this->transmitting) return 4;
+  this->transmitting = false;
+
+  i2cStats.transactions++;
+  i2cStats.bytes += this->length + 1;
+  if (i2cListener) i2cListener(this->address, this->buffer, this->length);
+  return 0;
+}
+
+void nativeSetI2CListener(NativeI2CListener listener) {
+  i2cListener = listener;
+}
+
+const NativeBusStats &nativeI2CStats() {
+  return i2cStats;
+}
+
+void nativeResetI2CStats() {
+  i2cStats = NativeBusStats();
+}
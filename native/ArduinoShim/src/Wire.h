@@ -0,0 +1,42 @@
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 128
+
+// I2C master. Transmissions are handed to the listener set through
+// NativeHost.h, reads return nothing.
+
+class TwoWire : public Stream {
+  public:
+    void begin(int sda, int scl) { (void) sda; (void) scl; }
+    void begin() {}
+    void setClock(uint32_t frequency) { this->frequency = frequency; }
+    uint32_t getClock() const { return this->frequency; }
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { this->beginTransmission((uint8_t) address); }
+    uint8_t endTransmission(uint8_t sendStop = true);
+
+    uint8_t requestFrom(uint8_t address, size_t size, bool sendStop = true) { (void) address; (void) size; (void) sendStop; return 0; }
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *data, size_t quantity) override;
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+
+  private:
+    uint32_t  frequency = 100000;
+    uint8_t   address = 0;
+    uint8_t   buffer[BUFFER_LENGTH];
+    size_t    length = 0;
+    bool      transmitting = false;
+};
+
+extern TwoWire Wire;
+
+#endif
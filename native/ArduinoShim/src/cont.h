@@ -0,0 +1,25 @@
+#ifndef cont_h
+#define cont_h
+
+#include <stdint.h>
+
+// Continuation (loop task) stack of the ESP8266 core, only the fields the
+// libraries inspect for diagnostics
+
+#define CONT_STACKSIZE 4096
+
+typedef struct cont_ {
+  uint32_t stack[CONT_STACKSIZE / 4];
+} cont_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int cont_get_free_stack(cont_t *cont);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
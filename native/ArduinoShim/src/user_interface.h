@@ -0,0 +1,21 @@
+#ifndef user_interface_h
+#define user_interface_h
+
+#include <stdint.h>
+
+// Subset of the ESP8266 SDK used by the libraries
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t system_get_free_heap_size(void);
+uint32_t system_get_time(void);
+uint8_t wifi_softap_get_station_num(void);
+bool wifi_station_disconnect(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef ColumnDownsampler_h
+#define ColumnDownsampler_h
+
+#include <stdint.h>
+#include "RingSeries.h"
+
+// Maps a long sample series onto a fixed number of display columns.
+//
+// Every column covers `samplesPerColumn` consecutive samples and is
+// finished as soon as its last sample arrives, so the cost per sample is
+// constant and nothing is recomputed per frame. A column is stored as the
+// vertical span the renderer has to draw, which keeps the trace connected
+// to the previous column.
+//
+//  DOWNSAMPLE_MINMAX  span covers every sample of the column, short
+//                     spikes always stay visible
+//  DOWNSAMPLE_LTTB    Largest-Triangle-Three-Buckets, keeps the sample that
+//                     best preserves the visual shape. A column can only be
+//                     decided once the next one is complete, so LTTB lags
+//                     one column behind.
+
+enum DownsampleMode {
+  DOWNSAMPLE_MINMAX,
+  DOWNSAMPLE_LTTB
+};
+
+struct ColumnSpan {
+  int16_t   low;
+  int16_t   high;
+};
+
+template <uint16_t Columns, uint16_t MaxSamplesPerColumn>
+class ColumnDownsampler {
+  public:
+    ColumnDownsampler(uint16_t samplesPerColumn, DownsampleMode mode = DOWNSAMPLE_MINMAX) {
+      this->samplesPerColumn = samplesPerColumn > MaxSamplesPerColumn ? MaxSamplesPerColumn : samplesPerColumn;
+      this->mode = mode;
+    }
+
+    void push(int16_t value) {
+      if (this->fill == 0) {
+        this->low = this->high = value;
+        this->sum = 0;
+      } else {
+        if (value < this->low) this->low = value;
+        if (value > this->high) this->high = value;
+      }
+      this->sum += value;
+      if (this->mode == DOWNSAMPLE_LTTB) this->pending[this->fill] = value;
+
+      if (++this->fill < this->samplesPerColumn) return;
+      this->fill = 0;
+
+      if (this->mode == DOWNSAMPLE_MINMAX) {
+        this->emit(this->low, this->high, value);
+      } else {
+        this->completeLttb();
+      }
+    }
+
+    void clear() {
+      this->spans.clear();
+      this->completed = 0;
+      this->fill = 0;
+      this->hasPrevious = false;
+      this->hasBucket = false;
+    }
+
+    // Finished columns, oldest first
+    const RingBuffer<ColumnSpan, Columns> &columns() const {
+      return this->spans;
+    }
+
+    // Columns finished since the last clear(), lets consumers detect new
+    // columns without comparing contents
+    uint32_t completedColumns() const {
+      return this->completed;
+    }
+
+    static uint16_t columnCount() { return Columns; }
+
+  private:
+    RingBuffer<ColumnSpan, Columns>  spans;
+    DownsampleMode                   mode;
+    uint16_t                         samplesPerColumn;
+    uint32_t                         completed    = 0;
+
+    // Column being collected
+    uint16_t                         fill         = 0;
+    int16_t                          low          = 0;
+    int16_t                          high         = 0;
+    int32_t                          sum          = 0;
+    int16_t                          pending[MaxSamplesPerColumn];
+
+    // Last value of the previous column, the trace continues from it
+    bool                             hasPrevious  = false;
+    int16_t                          previous     = 0;
+
+    // LTTB: complete column waiting for the average of its successor
+    bool                             hasBucket    = false;
+    int16_t                          bucket[MaxSamplesPerColumn];
+    uint16_t                         selectedX    = 0; // index of the previous pick within its column
+
+    void emit(int16_t low, int16_t high, int16_t last) {
+      if (this->hasPrevious) {
+        if (this->previous < low) low = this->previous;
+        if (this->previous > high) high = this->previous;
+      }
+      ColumnSpan span;
+      span.low = low;
+      span.high = high;
+      this->spans.push(span);
+      this->completed++;
+      this->previous = last;
+      this->hasPrevious = true;
+    }
+
+    void completeLttb() {
+      uint16_t n = this->samplesPerColumn;
+
+      if (this->hasBucket) {
+        // Points in sample units, the buffered column starts at x = 0.
+        // A is the previous pick, C the average of the column just completed.
+        int32_t ax = (int32_t) this->selectedX - n;
+        int32_t ay = this->previous;
+        int32_t cx = n + (n - 1) / 2;
+        int32_t cy = this->sum / n;
+
+        uint16_t best = 0;
+        int32_t bestArea = -1;
+        for (uint16_t i = 0; i < n; i++) {
+          // Twice the triangle area, the factor does not change the pick
+          int32_t area = (ax - cx) * ((int32_t) this->bucket[i] - ay) - (ax - (int32_t) i) * (cy - ay);
+          if (area < 0) area = -area;
+          if (area > bestArea) {
+            bestArea = area;
+            best = i;
+          }
+        }
+
+        this->selectedX = best;
+        int16_t pick = this->bucket[best];
+        this->emit(pick, pick, pick);
+      } else {
+        // Very first column, anchor the trace at its first sample
+        // (x = selectedX - n = 0 in the coordinates used above)
+        this->previous = this->pending[0];
+        this->selectedX = n;
+        this->hasPrevious = true;
+      }
+
+      for (uint16_t i = 0; i < n; i++) {
+        this->bucket[i] = this->pending[i];
+      }
+      this->hasBucket = true;
+    }
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef Decimator_h
+#define Decimator_h
+
+#include <stdint.h>
+
+// Fixed-point CIC decimator for oversampled ADC readings.
+//
+// Accumulates 2^RateLog2 input samples per output through `Order`
+// integrator/comb stages (Order 1 is a plain boxcar average). The output
+// is left-justified to 16 bits, so every extra bit gained by averaging is
+// kept instead of being truncated back to the ADC resolution.
+//
+// Integrators wrap modulo 2^32 by design; the combs undo the wrap as long
+// as the full gain fits: InputBits + Order * RateLog2 <= 32.
+
+template <uint8_t InputBits, uint8_t RateLog2, uint8_t Order = 1>
+class Decimator {
+  static_assert(Order >= 1 && Order <= 4, "Decimator order must be 1..4");
+  static_assert(InputBits + Order * RateLog2 <= 32, "Decimator gain overflows 32 bits");
+
+  public:
+    static const uint8_t  OUTPUT_BITS = 16;
+    static const uint8_t  GAIN_BITS   = InputBits + Order * RateLog2;
+    static const uint16_t RATE        = 1 << RateLog2;
+
+    // Feed one input sample, returns true when `output` holds a new value
+    bool push(uint16_t input, uint16_t &output) {
+      uint32_t value = input;
+      for (uint8_t i = 0; i < Order; i++) {
+        this->integrator[i] += value;
+        value = this->integrator[i];
+      }
+
+      if (++this->phase < RATE) return false;
+      this->phase = 0;
+
+      for (uint8_t i = 0; i < Order; i++) {
+        uint32_t delayed = this->comb[i];
+        this->comb[i] = value;
+        value -= delayed;
+      }
+
+      output = normalize(value);
+      return true;
+    }
+
+    void reset() {
+      for (uint8_t i = 0; i < Order; i++) {
+        this->integrator[i] = 0;
+        this->comb[i] = 0;
+      }
+      this->phase = 0;
+    }
+
+  private:
+    uint32_t  integrator[Order] = {0};
+    uint32_t  comb[Order]       = {0};
+    uint16_t  phase             = 0;
+
+    static const uint8_t  SHIFT_DOWN  = GAIN_BITS > OUTPUT_BITS ? GAIN_BITS - OUTPUT_BITS : 0;
+    static const uint8_t  SHIFT_UP    = OUTPUT_BITS > GAIN_BITS ? OUTPUT_BITS - GAIN_BITS : 0;
+
+    static inline uint16_t normalize(uint32_t value) {
+      return (value >> SHIFT_DOWN) << SHIFT_UP;
+    }
+};
+
+#endif
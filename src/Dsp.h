@@ -0,0 +1,184 @@
+#ifndef Dsp_h
+#define Dsp_h
+
+#include <stdint.h>
+
+// Integer filters for the sample path.
+//
+// The ESP8266 has no FPU, so every filter runs on integers only. Biquad
+// coefficients are designed with `constexpr` functions: declare them as
+// `constexpr` constants and the compiler evaluates the trigonometry, no
+// float code or tables end up in the firmware.
+//
+// Every filter primes its state with the first sample it sees, so there
+// is no start-up step from zero.
+
+namespace Dsp {
+
+  // -/----- Compile-time math -----\-
+
+  constexpr double Pi = 3.14159265358979323846;
+
+  // Taylor series, converges quickly for |x| <= Pi
+  constexpr double cosSeries(double x2, double term, unsigned n) {
+    return n > 12 ? term : term + cosSeries(x2, -term * x2 / ((2 * n + 1) * (2 * n + 2)), n + 1);
+  }
+
+  constexpr double cos(double x) {
+    return cosSeries(x * x, 1.0, 0);
+  }
+
+  constexpr double sin(double x) {
+    return cos(Pi / 2 - x);
+  }
+
+  // -/----- Biquad IIR -----\-
+
+  // Coefficients in Q14, |a1| may reach 2 so Q15 would not fit
+  const uint8_t BIQUAD_SHIFT = 14;
+
+  constexpr int32_t q14(double value) {
+    return value >= 0 ? (int32_t) (value * (1 << BIQUAD_SHIFT) + 0.5) : -(int32_t) (-value * (1 << BIQUAD_SHIFT) + 0.5);
+  }
+
+  struct BiquadCoeffs {
+    int32_t b0, b1, b2, a1, a2;
+
+    constexpr BiquadCoeffs(double b0, double b1, double b2, double a0, double a1, double a2)
+      : b0(q14(b0 / a0)), b1(q14(b1 / a0)), b2(q14(b2 / a0)), a1(q14(a1 / a0)), a2(q14(a2 / a0)) {}
+  };
+
+  // RBJ cookbook designs, frequencies in Hz
+  constexpr double omega(double f0, double fs) {
+    return 2 * Pi * f0 / fs;
+  }
+
+  constexpr double alpha(double f0, double fs, double q) {
+    return sin(omega(f0, fs)) / (2 * q);
+  }
+
+  constexpr BiquadCoeffs lowpass(double f0, double fs, double q) {
+    return BiquadCoeffs(
+      (1 - cos(omega(f0, fs))) / 2, 1 - cos(omega(f0, fs)), (1 - cos(omega(f0, fs))) / 2,
+      1 + alpha(f0, fs, q), -2 * cos(omega(f0, fs)), 1 - alpha(f0, fs, q));
+  }
+
+  constexpr BiquadCoeffs notch(double f0, double fs, double q) {
+    return BiquadCoeffs(
+      1, -2 * cos(omega(f0, fs)), 1,
+      1 + alpha(f0, fs, q), -2 * cos(omega(f0, fs)), 1 - alpha(f0, fs, q));
+  }
+
+  // Direct form I with a 64-bit accumulator, no internal overflow
+  class Biquad {
+    public:
+      Biquad(const BiquadCoeffs &coeffs) : c(coeffs) {}
+
+      int32_t filter(int32_t x) {
+        if (!this->primed) {
+          this->x1 = this->x2 = this->y1 = this->y2 = x;
+          this->primed = true;
+        }
+        int64_t acc = (int64_t) c.b0 * x + (int64_t) c.b1 * this->x1 + (int64_t) c.b2 * this->x2
+                    - (int64_t) c.a1 * this->y1 - (int64_t) c.a2 * this->y2;
+        int32_t y = (int32_t) ((acc + (1 << (BIQUAD_SHIFT - 1))) >> BIQUAD_SHIFT);
+        this->x2 = this->x1;
+        this->x1 = x;
+        this->y2 = this->y1;
+        this->y1 = y;
+        return y;
+      }
+
+      void reset() {
+        this->primed = false;
+      }
+
+    private:
+      BiquadCoeffs  c;
+      int32_t       x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+      bool          primed = false;
+  };
+
+  // -/----- Exponential moving average -----\-
+
+  // y += (x - y) / 2^Shift, the state keeps Shift fractional bits
+  template <uint8_t Shift>
+  class Ema {
+    static_assert(Shift >= 1 && Shift <= 15, "Ema shift must be 1..15");
+
+    public:
+      int32_t filter(int32_t x) {
+        int32_t scaled = x << Shift;
+        if (!this->primed) {
+          this->state = scaled;
+          this->primed = true;
+        }
+        this->state += (scaled - this->state) >> Shift;
+        return (this->state + (1 << (Shift - 1))) >> Shift;
+      }
+
+      void reset() {
+        this->primed = false;
+      }
+
+    private:
+      int32_t   state = 0;
+      bool      primed = false;
+  };
+
+  // -/----- Running median -----\-
+
+  // Median of the last N samples. Keeps a sorted copy of the window and
+  // moves one element per sample, O(N) for the small windows we need.
+  template <typename T, uint8_t N>
+  class Median {
+    static_assert(N % 2 == 1 && N <= 31, "Median window must be odd and small");
+
+    public:
+      T filter(T x) {
+        if (!this->primed) {
+          for (uint8_t i = 0; i < N; i++) {
+            this->window[i] = this->sorted[i] = x;
+          }
+          this->primed = true;
+          return x;
+        }
+
+        T old = this->window[this->pos];
+        this->window[this->pos] = x;
+        if (++this->pos == N) this->pos = 0;
+
+        // Find the outgoing value and slide the new one into its place
+        uint8_t i = 0;
+        while (this->sorted[i] != old) i++;
+        while (i > 0 && this->sorted[i - 1] > x) {
+          this->sorted[i] = this->sorted[i - 1];
+          i--;
+        }
+        while (i < N - 1 && this->sorted[i + 1] < x) {
+          this->sorted[i] = this->sorted[i + 1];
+          i++;
+        }
+        this->sorted[i] = x;
+
+        return this->sorted[N / 2];
+      }
+
+      void reset() {
+        this->primed = false;
+        this->pos = 0;
+      }
+
+    private:
+      T         window[N];
+      T         sorted[N];
+      uint8_t   pos = 0;
+      bool      primed = false;
+  };
+
+  inline uint16_t clamp16(int32_t value) {
+    return value < 0 ? 0 : value > 0xFFFF ? 0xFFFF : value;
+  }
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "MeasurementFsm.h"
+
+// Next state for every (state, input) pair
+static const uint8_t transitions[STATE_COUNT][INPUT_COUNT] = {
+  //                   INPUT_OPEN       INPUT_WEAK       INPUT_SIGNAL      INPUT_SHORT
+  /* STATE_IDLE      */ { STATE_IDLE,     STATE_CONTACT,   STATE_MEASURING,  STATE_SHORT },
+  /* STATE_CONTACT   */ { STATE_IDLE,     STATE_CONTACT,   STATE_MEASURING,  STATE_SHORT },
+  /* STATE_MEASURING */ { STATE_RELEASED, STATE_MEASURING, STATE_MEASURING,  STATE_SHORT },
+  /* STATE_SHORT     */ { STATE_RELEASED, STATE_CONTACT,   STATE_MEASURING,  STATE_SHORT },
+  /* STATE_RELEASED  */ { STATE_IDLE,     STATE_CONTACT,   STATE_MEASURING,  STATE_SHORT },
+};
+
+MeasurementFsm::MeasurementFsm(const MeasurementThresholds &thresholds) {
+  this->thresholds = thresholds;
+}
+
+MeasurementInput MeasurementFsm::classify(int16_t value) {
+  const MeasurementThresholds &t = this->thresholds;
+
+  MeasurementInput level = INPUT_OPEN;
+  if (value >= t.saturated) {
+    level = INPUT_SHORT;
+  } else if (value > t.signal) {
+    level = INPUT_SIGNAL;
+  } else if (value >= t.weak) {
+    level = INPUT_WEAK;
+  }
+
+  // Only fall back to a lower level once the value clears the hysteresis
+  if (level < this->input) {
+    int16_t bound = 0;
+    switch (this->input) {
+      case INPUT_SHORT:  bound = t.saturated; break;
+      case INPUT_SIGNAL: bound = t.signal + 1; break;
+      case INPUT_WEAK:   bound = t.weak; break;
+      default: break;
+    }
+    if (value > bound - 1 - t.hysteresis) return this->input;
+  }
+  return level;
+}
+
+bool MeasurementFsm::push(int16_t value, uint32_t now) {
+  this->input = classify(value);
+  MeasurementState next = (MeasurementState) transitions[this->current][this->input];
+
+  if (next == this->current) {
+    this->dwell = 0;
+    return false;
+  }
+
+  // The requested state has to persist for its dwell time
+  if (next != this->candidate) {
+    this->candidate = next;
+    this->dwell = 0;
+  }
+  if (++this->dwell < this->thresholds.dwell[next]) return false;
+
+  MeasurementEvent event;
+  event.state = next;
+  event.previous = this->current;
+  event.value = value;
+  event.time = now;
+  this->queue.push(event);
+
+  this->current = next;
+  this->dwell = 0;
+  return true;
+}
+
+void MeasurementFsm::reset() {
+  this->current = STATE_IDLE;
+  this->input = INPUT_OPEN;
+  this->candidate = STATE_IDLE;
+  this->dwell = 0;
+}
+
+const char *MeasurementFsm::stateName(MeasurementState state) {
+  switch (state) {
+    case STATE_IDLE:      return "IDLE";
+    case STATE_CONTACT:   return "CONTACT";
+    case STATE_MEASURING: return "MEASURE";
+    case STATE_SHORT:     return "SHORT";
+    case STATE_RELEASED:  return "RELEASED";
+    default:              return "";
+  }
+}
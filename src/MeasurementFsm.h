@@ -0,0 +1,79 @@
+#ifndef MeasurementFsm_h
+#define MeasurementFsm_h
+
+#include <stdint.h>
+#include "SampleRing.h"
+
+// Table-driven detector for probe contact, measurement, short circuit and
+// release.
+//
+// Every sample is classified into an input level with hysteresis, the
+// transition table maps (state, input) to the next state, and a new state
+// is only entered after it has been requested for its minimum dwell time.
+// State changes are published as typed events; consumers attach their own
+// cursor to events() and react to those instead of re-deriving the state
+// from raw samples.
+
+enum MeasurementState {
+  STATE_IDLE,        // nothing connected
+  STATE_CONTACT,     // probe touches, signal below the measuring level
+  STATE_MEASURING,   // valid reading
+  STATE_SHORT,       // input saturated
+  STATE_RELEASED,    // probe lifted after contact, falls back to idle
+  STATE_COUNT
+};
+
+enum MeasurementInput {
+  INPUT_OPEN,
+  INPUT_WEAK,
+  INPUT_SIGNAL,
+  INPUT_SHORT,
+  INPUT_COUNT
+};
+
+struct MeasurementEvent {
+  MeasurementState  state;     // state entered
+  MeasurementState  previous;  // state left
+  int16_t           value;     // sample that completed the transition
+  uint32_t          time;      // millis() of the transition
+};
+
+typedef SampleRing<MeasurementEvent, 16> MeasurementEvents;
+
+struct MeasurementThresholds {
+  int16_t   weak;                  // at or above: probe contact
+  int16_t   signal;                // above: measuring
+  int16_t   saturated;             // at or above: short
+  int16_t   hysteresis;            // margin to fall back to a lower input
+  uint16_t  dwell[STATE_COUNT];    // samples a state must be requested before it is entered
+};
+
+class MeasurementFsm {
+  public:
+    MeasurementFsm(const MeasurementThresholds &thresholds);
+
+    // Classify one sample and advance the state machine.
+    // Returns true if the state changed.
+    bool push(int16_t value, uint32_t now);
+
+    void reset();
+
+    MeasurementState state() const { return this->current; }
+
+    // Attach consumers here, they receive every transition in order
+    MeasurementEvents &events() { return this->queue; }
+
+    static const char *stateName(MeasurementState state);
+
+  private:
+    MeasurementThresholds   thresholds;
+    MeasurementState        current   = STATE_IDLE;
+    MeasurementInput        input     = INPUT_OPEN;
+    MeasurementState        candidate = STATE_IDLE;
+    uint16_t                dwell     = 0;
+    MeasurementEvents       queue;
+
+    MeasurementInput classify(int16_t value);
+};
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef RingSeries_h
+#define RingSeries_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Fixed-capacity time series containers.
+//
+// Both containers overwrite their oldest element once full. Indexing is
+// relative to the oldest element: series[0] is the oldest sample and
+// series[size() - 1] the newest, and iteration runs oldest to newest, so
+// renderers can walk the history in time order without shifting or
+// copying anything.
+
+template <typename T, uint16_t N>
+class RingBuffer {
+  static_assert(N > 0 && N < 0x8000, "RingBuffer capacity must be 1..32767");
+
+  public:
+    class Iterator {
+      public:
+        Iterator(const RingBuffer *ring, uint16_t index) : ring(ring), index(index) {}
+
+        const T &operator*() const { return (*this->ring)[this->index]; }
+        Iterator &operator++() { this->index++; return *this; }
+        bool operator!=(const Iterator &other) const { return this->index != other.index; }
+
+      private:
+        const RingBuffer  *ring;
+        uint16_t           index;
+    };
+
+    // O(1), returns the evicted element through `evicted` when full
+    bool push(const T &value, T *evicted = NULL) {
+      bool full = this->count == N;
+      if (full && evicted) *evicted = this->items[this->head];
+      this->items[this->head] = value;
+      if (++this->head == N) this->head = 0;
+      if (!full) this->count++;
+      return full;
+    }
+
+    void clear() {
+      this->head = 0;
+      this->count = 0;
+    }
+
+    uint16_t size() const { return this->count; }
+    bool empty() const { return this->count == 0; }
+    bool full() const { return this->count == N; }
+    static uint16_t capacity() { return N; }
+
+    // 0 is the oldest element
+    const T &operator[](uint16_t index) const {
+      uint16_t pos = this->head + N - this->count + index;
+      return this->items[pos >= N ? pos - N : pos];
+    }
+
+    const T &oldest() const { return (*this)[0]; }
+    const T &newest() const { return (*this)[this->count - 1]; }
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, this->count); }
+
+  private:
+    T         items[N];
+    uint16_t  head  = 0; // next slot to write
+    uint16_t  count = 0;
+};
+
+// RingBuffer that also maintains min, max and mean of its contents.
+//
+// The sum is updated on push and evict. Min and max use monotonic queues,
+// each sample enters and leaves them at most once, so all three stay
+// amortized O(1) per push and O(1) to query.
+template <typename T, uint16_t N, typename Sum = int32_t>
+class RingSeries : public RingBuffer<T, N> {
+  public:
+    void push(const T &value) {
+      T evicted;
+      if (RingBuffer<T, N>::push(value, &evicted)) {
+        this->sum -= evicted;
+      }
+      this->sum += value;
+
+      // Drop extremes that just left the window, then queue the new sample
+      uint16_t seq = this->pushed++;
+      uint16_t oldestSeq = seq - (this->size() - 1);
+      this->minQueue.expire(oldestSeq);
+      this->maxQueue.expire(oldestSeq);
+      this->minQueue.push(seq, value, false);
+      this->maxQueue.push(seq, value, true);
+    }
+
+    void clear() {
+      RingBuffer<T, N>::clear();
+      this->sum = 0;
+      this->minQueue.clear();
+      this->maxQueue.clear();
+    }
+
+    // Only meaningful when the series is not empty
+    T min() const { return this->minQueue.front(); }
+    T max() const { return this->maxQueue.front(); }
+    Sum total() const { return this->sum; }
+    T mean() const { return this->empty() ? T() : (T) (this->sum / (Sum) this->size()); }
+
+  private:
+    // Candidates for the window extreme, ordered by age and by value
+    class MonotonicQueue {
+      public:
+        void push(uint16_t seq, const T &value, bool keepMax) {
+          while (this->count) {
+            const T &back = this->values[this->index(this->count - 1)];
+            if (keepMax ? back > value : back < value) break;
+            this->count--;
+          }
+          uint16_t pos = this->index(this->count);
+          this->seqs[pos] = seq;
+          this->values[pos] = value;
+          this->count++;
+        }
+
+        void expire(uint16_t oldestSeq) {
+          // Sequence numbers wrap, compare their distance instead
+          while (this->count && (uint16_t) (oldestSeq - this->seqs[this->first]) < 0x8000 && this->seqs[this->first] != oldestSeq) {
+            if (++this->first == N) this->first = 0;
+            this->count--;
+          }
+        }
+
+        void clear() {
+          this->first = 0;
+          this->count = 0;
+        }
+
+        const T &front() const { return this->values[this->first]; }
+
+      private:
+        uint16_t  seqs[N];
+        T         values[N];
+        uint16_t  first = 0;
+        uint16_t  count = 0;
+
+        uint16_t index(uint16_t offset) const {
+          uint16_t pos = this->first + offset;
+          return pos >= N ? pos - N : pos;
+        }
+    };
+
+    Sum             sum       = 0;
+    uint16_t        pushed    = 0;
+    MonotonicQueue  minQueue;
+    MonotonicQueue  maxQueue;
+};
+
+#endif
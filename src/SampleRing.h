@@ -0,0 +1,146 @@
+#ifndef SampleRing_h
+#define SampleRing_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Lock-free single-producer ring with independent consumer cursors.
+//
+// The producer (usually Sampler::poll()) never blocks: it always
+// writes and advances a free-running write index. Every consumer drains
+// the ring through its own Cursor, so a slow consumer only loses its own
+// oldest samples and never holds back the producer or the other consumers.
+
+#ifdef ESP8266
+// Single core: aligned 32-bit loads and stores are atomic, we only need to
+// keep the compiler from reordering the slot access around the index.
+#define SAMPLERING_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+
+typedef volatile uint32_t SampleRingIndex;
+
+inline uint32_t sampleRingLoad(const SampleRingIndex &index) {
+  uint32_t value = index;
+  SAMPLERING_BARRIER();
+  return value;
+}
+
+inline void sampleRingFence() {
+  SAMPLERING_BARRIER();
+}
+
+inline void sampleRingStore(SampleRingIndex &index, uint32_t value) {
+  SAMPLERING_BARRIER();
+  index = value;
+}
+#else
+#include <atomic>
+
+typedef std::atomic<uint32_t> SampleRingIndex;
+
+inline uint32_t sampleRingLoad(const SampleRingIndex &index) {
+  return index.load(std::memory_order_acquire);
+}
+
+inline void sampleRingStore(SampleRingIndex &index, uint32_t value) {
+  index.store(value, std::memory_order_release);
+}
+
+inline void sampleRingFence() {
+  std::atomic_thread_fence(std::memory_order_acquire);
+}
+#endif
+
+template <typename T, uint16_t N>
+class SampleRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "SampleRing size must be a power of two");
+
+  public:
+    class Cursor {
+      public:
+        // Number of unread samples, capped at what the ring can hold
+        uint16_t available() {
+          if (!this->ring) return 0;
+          uint32_t pending = sampleRingLoad(this->ring->writeIndex) - this->readIndex;
+          return pending > N - 1 ? N - 1 : pending;
+        }
+
+        // Read the oldest unread sample, returns false if there is none
+        bool read(T &value) {
+          return this->read(&value, 1) == 1;
+        }
+
+        // Read up to `count` samples in order, returns the number read
+        uint16_t read(T *values, uint16_t count) {
+          if (!this->ring) return 0;
+          uint16_t done = 0;
+          while (done < count) {
+            uint32_t write = sampleRingLoad(this->ring->writeIndex);
+            if (write == this->readIndex) break;
+            if (write - this->readIndex >= N) {
+              // The producer lapped us, skip to the oldest sample that is
+              // not about to be overwritten by the next push
+              this->lost += write - this->readIndex - (N - 1);
+              this->readIndex = write - (N - 1);
+            }
+
+            values[done] = this->ring->buffer[this->readIndex & (N - 1)];
+
+            // The slot may have been overwritten while we copied it
+            sampleRingFence();
+            write = sampleRingLoad(this->ring->writeIndex);
+            if (write - this->readIndex >= N) continue;
+
+            this->readIndex++;
+            done++;
+          }
+          return done;
+        }
+
+        // Drop everything that is pending
+        void skip() {
+          if (!this->ring) return;
+          this->readIndex = sampleRingLoad(this->ring->writeIndex);
+        }
+
+        // Samples this consumer lost because it fell behind
+        uint32_t lost = 0;
+
+      private:
+        friend class SampleRing;
+
+        const SampleRing  *ring      = NULL;
+        uint32_t           readIndex = 0;
+    };
+
+    SampleRing() : writeIndex(0) {}
+
+    // Producer only. Overwrites the oldest sample once the ring is full.
+    void push(const T &value) {
+      uint32_t write = sampleRingLoad(this->writeIndex);
+      this->buffer[write & (N - 1)] = value;
+      sampleRingStore(this->writeIndex, write + 1);
+    }
+
+    // Attach a consumer, it will see every sample pushed from now on
+    void attach(Cursor &cursor) const {
+      cursor.ring = this;
+      cursor.readIndex = sampleRingLoad(this->writeIndex);
+      cursor.lost = 0;
+    }
+
+    // Total number of samples pushed
+    uint32_t written() const {
+      return sampleRingLoad(this->writeIndex);
+    }
+
+    // One slot is kept free for the sample being written
+    static uint16_t capacity() {
+      return N - 1;
+    }
+
+  private:
+    T                   buffer[N];
+    SampleRingIndex     writeIndex;
+};
+
+#endif
@@ -0,0 +1,169 @@
+#include "Sampler.h"
+
+#ifdef ESP8266
+extern "C" {
+#include "user_interface.h"
+}
+#endif
+
+static Sampler *activeSampler = NULL;
+
+#ifdef ESP8266
+static void ICACHE_RAM_ATTR samplerTimerISR() {
+  activeSampler->tick();
+}
+#endif
+
+Sampler::Sampler(uint8_t pin, uint32_t rateHz) {
+  this->_pin = pin;
+  this->_rateHz = rateHz << SAMPLER_OVERSAMPLE_LOG2;
+  this->_raw.attach(this->_rawCursor);
+  // begin() measures again, the CPU clock may change before then
+  measureClock();
+}
+
+uint32_t ICACHE_RAM_ATTR Sampler::cycles() {
+#ifdef ESP8266
+  return ESP.getCycleCount();
+#else
+  return micros();
+#endif
+}
+
+void Sampler::measureClock() {
+#ifdef ESP8266
+  // The period timer1 runs at, 5 timer ticks per microsecond, so the due
+  // times do not drift away from the interrupts
+  this->_cyclesPerMicro = ESP.getCpuFreqMHz();
+  this->_periodCycles = (5000000UL / this->_rateHz) * this->_cyclesPerMicro / 5;
+#else
+  this->_cyclesPerMicro = 1;
+  this->_periodCycles = 1000000UL / this->_rateHz;
+#endif
+}
+
+void Sampler::begin() {
+  measureClock();
+  this->_decimator.reset();
+  this->_rawCursor.skip();
+  this->resetStats();
+  this->_nextCycles = cycles() + this->_periodCycles;
+  activeSampler = this;
+
+#ifdef ESP8266
+  // timer1 runs from the 80MHz APB clock regardless of the CPU clock,
+  // TIM_DIV16 gives 5 ticks per microsecond.
+  this->_timerDriven = true;
+  timer1_isr_init();
+  timer1_attachInterrupt(samplerTimerISR);
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
+  timer1_write(5000000UL / this->_rateHz);
+#endif
+}
+
+void Sampler::end() {
+#ifdef ESP8266
+  timer1_disable();
+  timer1_detachInterrupt();
+#endif
+  this->_timerDriven = false;
+  activeSampler = NULL;
+}
+
+void ICACHE_RAM_ATTR Sampler::tick() {
+  uint32_t due = this->_nextCycles;
+
+  // Held off for whole periods, their readings are lost
+  uint32_t late = cycles() - due;
+  if (late >= this->_periodCycles) {
+    uint32_t missed = late / this->_periodCycles;
+    this->_dropped += missed;
+    due += missed * this->_periodCycles;
+  }
+  this->_nextCycles = due + this->_periodCycles;
+
+  acquire(due);
+}
+
+void Sampler::poll() {
+  if (activeSampler != this) return;
+
+  if (!this->_timerDriven) {
+    // Count the periods the timer would have, at the times they were due
+    uint32_t now = cycles();
+    uint32_t pending = 0;
+    while ((int32_t) (now - this->_nextCycles) >= 0) {
+      this->_nextCycles += this->_periodCycles;
+      pending++;
+    }
+
+    // Readings that late no longer belong to their period
+    if (pending > SAMPLER_CATCH_UP) {
+      this->_dropped += pending - SAMPLER_CATCH_UP;
+      pending = SAMPLER_CATCH_UP;
+    }
+
+    // Oldest first, each against its own due time
+    for (uint32_t i = pending; i > 0; i--) {
+      acquire(this->_nextCycles - i * this->_periodCycles);
+    }
+  }
+
+  uint16_t reading;
+  uint16_t output;
+  while (this->_rawCursor.read(reading)) {
+    if (this->_decimator.push(reading, output)) {
+      if (this->_filter) output = this->_filter(output);
+      this->_ring.push(output);
+    }
+  }
+}
+
+void ICACHE_RAM_ATTR Sampler::acquire(uint32_t due) {
+  uint32_t late = cycles() - due;
+  if (late > this->_jitterMax) this->_jitterMax = late;
+  this->_jitterSum += late;
+
+#ifdef ESP8266
+  // What analogRead(A0) comes down to
+  this->_raw.push(system_adc_read());
+#else
+  this->_raw.push(analogRead(this->_pin));
+#endif
+  this->_samples++;
+}
+
+void Sampler::attach(SamplerRing::Cursor &cursor) {
+  this->_ring.attach(cursor);
+}
+
+void Sampler::setFilter(SampleFilter filter) {
+  this->_filter = filter;
+}
+
+void Sampler::getStats(SamplerStats &stats) {
+  // Consistent with the interrupt, it writes all but the raw losses
+  noInterrupts();
+  stats.samples = this->_samples;
+  stats.dropped = this->_dropped;
+  uint32_t jitterMax = this->_jitterMax;
+  uint64_t jitterSum = this->_jitterSum;
+  interrupts();
+  stats.dropped += this->_rawCursor.lost;
+
+  uint32_t elapsed = millis() - this->_statsStart;
+  stats.achievedRate = elapsed ? (uint64_t) stats.samples * 1000 / elapsed : 0;
+  stats.jitterMax = jitterMax / this->_cyclesPerMicro;
+  stats.jitterMean = stats.samples ? jitterSum / stats.samples / this->_cyclesPerMicro : 0;
+}
+
+void Sampler::resetStats() {
+  noInterrupts();
+  this->_samples = 0;
+  this->_dropped = 0;
+  this->_jitterMax = 0;
+  this->_jitterSum = 0;
+  interrupts();
+  this->_rawCursor.lost = 0;
+  this->_statsStart = millis();
+}
@@ -0,0 +1,138 @@
+#ifndef Sampler_h
+#define Sampler_h
+
+#include <Arduino.h>
+#include "SampleRing.h"
+#include "Decimator.h"
+
+// Fixed-rate ADC acquisition, decoupled from the UI and network loop.
+//
+// On the ESP8266 the hardware timer1 interrupt takes every reading when
+// its period fires, so the readings stay evenly spaced however late
+// OLEDDisplayUi::update() or THiNX::loop() return. The core masks timer1
+// around its flash writes (ESP.flashWrite(), used by SPIFFS and Updater),
+// so the interrupt never runs while the flash cache is off. It only reads
+// the ADC and queues the raw value; poll() decimates and filters the
+// queued readings in task context. Call it from loop() and while waiting,
+// at least every SAMPLER_RAW_BUFFER_SIZE - 1 periods.
+//
+// Where no timer is available (host builds) poll() counts the periods
+// against the clock and takes the readings that are due itself, at most
+// SAMPLER_CATCH_UP of them back to back.
+//
+// Statistics are measured against the due times on both targets: a reading
+// taken late adds to the jitter, a period without a reading counts as
+// dropped, and so does a reading poll() fetched too late.
+//
+// A0 is oversampled by 2^SAMPLER_OVERSAMPLE_LOG2 and decimated, consumers
+// receive 16-bit left-justified samples at SAMPLER_RATE_HZ with the
+// averaging gain kept in the low bits.
+
+// Output rate after decimation
+#ifndef SAMPLER_RATE_HZ
+#define SAMPLER_RATE_HZ 125
+#endif
+
+#ifndef SAMPLER_OVERSAMPLE_LOG2
+#define SAMPLER_OVERSAMPLE_LOG2 3
+#endif
+
+// 1 is a boxcar average, higher orders attenuate aliases further
+#ifndef SAMPLER_CIC_ORDER
+#define SAMPLER_CIC_ORDER 1
+#endif
+
+#define SAMPLER_ADC_BITS 10
+#define SAMPLER_ADC_SHIFT (16 - SAMPLER_ADC_BITS)
+
+// Late periods poll() still reads without a timer, one output sample by
+// default
+#ifndef SAMPLER_CATCH_UP
+#define SAMPLER_CATCH_UP (1 << SAMPLER_OVERSAMPLE_LOG2)
+#endif
+
+// Raw readings queued between the interrupt and poll(), must be a power
+// of two. 64 keeps 63 ms at the default rate.
+#ifndef SAMPLER_RAW_BUFFER_SIZE
+#define SAMPLER_RAW_BUFFER_SIZE 64
+#endif
+
+typedef Decimator<SAMPLER_ADC_BITS, SAMPLER_OVERSAMPLE_LOG2, SAMPLER_CIC_ORDER> SamplerDecimator;
+
+// Must be a power of two
+#ifndef SAMPLER_BUFFER_SIZE
+#define SAMPLER_BUFFER_SIZE 128
+#endif
+
+typedef SampleRing<uint16_t, SAMPLER_BUFFER_SIZE> SamplerRing;
+typedef SampleRing<uint16_t, SAMPLER_RAW_BUFFER_SIZE> SamplerRawRing;
+
+// Optional filter applied to every decimated sample before it is queued,
+// runs from poll()
+typedef uint16_t (*SampleFilter)(uint16_t sample);
+
+struct SamplerStats {
+  uint32_t samples      = 0; // ADC readings since the last reset
+  uint32_t dropped      = 0; // periods left unread
+  uint32_t achievedRate = 0; // ADC readings per second since the last reset
+  uint32_t jitterMax    = 0; // worst delay of a reading after its due time in us
+  uint32_t jitterMean   = 0; // mean delay of a reading after its due time in us
+};
+
+class Sampler {
+  public:
+    // rateHz is the output rate, the ADC runs 2^SAMPLER_OVERSAMPLE_LOG2 faster
+    Sampler(uint8_t pin, uint32_t rateHz);
+
+    // Start/stop the acquisition timer
+    void begin();
+    void end();
+
+    // Filter the queued readings into the consumers' ring, and without a
+    // timer take the readings that are due first
+    void poll();
+
+    // Attach a consumer to the acquired samples. Every consumer reads
+    // through its own cursor and may fall behind without affecting others.
+    void attach(SamplerRing::Cursor &cursor);
+
+    // Install the filter stage between decimation and the consumers
+    void setFilter(SampleFilter filter);
+
+    void getStats(SamplerStats &stats);
+    void resetStats();
+
+    // Take the reading of the period that fired, called from the timer
+    // interrupt
+    void tick();
+
+  private:
+    uint8_t             _pin;
+    uint32_t            _rateHz;
+    uint32_t            _periodCycles;
+    uint32_t            _cyclesPerMicro;
+    bool                _timerDriven             = false;
+
+    SamplerRing         _ring;
+    SamplerRawRing      _raw;
+    SamplerRawRing::Cursor _rawCursor;
+    SamplerDecimator    _decimator;
+    SampleFilter        _filter                  = NULL;
+
+    // When the next period is due, advanced by the interrupt on the ESP8266
+    // and by poll() without a timer
+    volatile uint32_t   _nextCycles              = 0;
+
+    // Statistics, written where the readings are taken
+    volatile uint32_t   _samples                 = 0;
+    volatile uint32_t   _dropped                 = 0;
+    volatile uint32_t   _jitterMax               = 0;
+    uint64_t            _jitterSum               = 0;
+    uint32_t            _statsStart              = 0;
+
+    uint32_t            cycles();
+    void                measureClock();
+    void                acquire(uint32_t due);
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef StatsEngine_h
+#define StatsEngine_h
+
+#include <stdint.h>
+#include "RingSeries.h"
+
+// Incremental measurement statistics, O(1) per sample and integer only.
+//
+//  - session mean/variance (Welford, mean in Q16)
+//  - peak value, when it happened and the drop since
+//  - least-squares slope over the last `Window` samples
+//  - a "reading has stabilised" detector: the window range and slope stay
+//    inside their limits for a minimum number of samples
+//
+// Everything is updated on push(), queries never rescan any history.
+
+template <uint16_t Window>
+class StatsEngine {
+  static_assert(Window >= 2, "StatsEngine window needs at least two samples");
+
+  public:
+    StatsEngine(uint16_t sampleRateHz) {
+      this->sampleRateHz = sampleRateHz;
+    }
+
+    // Samples are considered stable once the window range is at most
+    // `band` and |slope| at most `slope` (milli-units per second) for
+    // `dwell` consecutive samples
+    void setStability(int16_t band, int32_t slope, uint16_t dwell) {
+      this->stableBand = band;
+      this->stableSlope = slope;
+      this->stableDwell = dwell;
+    }
+
+    void push(int16_t value, uint32_t now) {
+      // Welford
+      this->n++;
+      int32_t x = (int32_t) value << 16;
+      int32_t delta = x - this->meanQ16;
+      this->meanQ16 += delta / (int32_t) this->n;
+      this->m2Q16 += ((int64_t) delta * (x - this->meanQ16)) >> 16;
+
+      // Peak
+      if (this->n == 1 || value > this->peakValue) {
+        this->peakValue = value;
+        this->peakTime = now;
+      }
+      this->lastValue = value;
+
+      // Sliding regression, x is the sample index within the window
+      int16_t oldest = 0;
+      bool full = this->window.full();
+      if (full) oldest = this->window.oldest();
+      int32_t sumBefore = this->window.total();
+      this->window.push(value);
+      if (full) {
+        this->sumXY += -(sumBefore - oldest) + (int32_t) (Window - 1) * value;
+      } else {
+        this->sumXY += (int32_t) (this->window.size() - 1) * value;
+      }
+
+      // Stability
+      bool inBand = this->window.full() &&
+                    this->window.max() - this->window.min() <= this->stableBand;
+      int32_t s = this->slope();
+      if (inBand && s <= this->stableSlope && s >= -this->stableSlope) {
+        if (this->stableCount < this->stableDwell) this->stableCount++;
+      } else {
+        this->stableCount = 0;
+      }
+    }
+
+    void reset() {
+      this->n = 0;
+      this->meanQ16 = 0;
+      this->m2Q16 = 0;
+      this->peakValue = 0;
+      this->peakTime = 0;
+      this->lastValue = 0;
+      this->window.clear();
+      this->sumXY = 0;
+      this->stableCount = 0;
+    }
+
+    uint32_t count() const { return this->n; }
+
+    int16_t mean() const { return (this->meanQ16 + (1 << 15)) >> 16; }
+
+    // Sample variance in units^2
+    uint32_t variance() const {
+      return this->n > 1 ? (uint32_t) ((this->m2Q16 / (this->n - 1) + (1 << 15)) >> 16) : 0;
+    }
+
+    uint16_t stddev() const {
+      // Integer square root, bit by bit
+      uint32_t v = this->variance();
+      uint32_t root = 0;
+      uint32_t bit = 1UL << 30;
+      while (bit > v) bit >>= 2;
+      while (bit) {
+        if (v >= root + bit) {
+          v -= root + bit;
+          root = (root >> 1) + bit;
+        } else {
+          root >>= 1;
+        }
+        bit >>= 2;
+      }
+      return root;
+    }
+
+    int16_t peak() const { return this->peakValue; }
+    int16_t last() const { return this->lastValue; }
+    int16_t dropFromPeak() const { return this->peakValue - this->lastValue; }
+    uint32_t timeSincePeak(uint32_t now) const { return this->n ? now - this->peakTime : 0; }
+
+    // Least-squares slope over the window in milli-units per second
+    int32_t slope() const {
+      int32_t count = this->window.size();
+      if (count < 2) return 0;
+      int64_t sumX = (int64_t) count * (count - 1) / 2;
+      int64_t sumXX = (int64_t) (count - 1) * count * (2 * count - 1) / 6;
+      int64_t numerator = (int64_t) count * this->sumXY - sumX * this->window.total();
+      int64_t denominator = (int64_t) count * sumXX - sumX * sumX;
+      return (int32_t) (numerator * 1000 * this->sampleRateHz / denominator);
+    }
+
+    bool stable() const {
+      return this->stableDwell && this->stableCount >= this->stableDwell;
+    }
+
+  private:
+    uint16_t                    sampleRateHz;
+
+    uint32_t                    n            = 0;
+    int32_t                     meanQ16      = 0;
+    int64_t                     m2Q16        = 0;
+
+    int16_t                     peakValue    = 0;
+    uint32_t                    peakTime     = 0;
+    int16_t                     lastValue    = 0;
+
+    RingSeries<int16_t, Window> window;
+    int32_t                     sumXY        = 0;
+
+    int16_t                     stableBand   = 0;
+    int32_t                     stableSlope  = 0;
+    uint16_t                    stableDwell  = 0;
+    uint16_t                    stableCount  = 0;
+};
+
+#endif
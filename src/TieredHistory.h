@@ -0,0 +1,109 @@
+#ifndef TieredHistory_h
+#define TieredHistory_h
+
+#include <stdint.h>
+#include "RingSeries.h"
+
+// Multi-resolution rolling history.
+//
+// Every tier keeps the last N buckets of min/max/mean at its own time
+// resolution. Tier 0 merges `spans[0]` samples per bucket, every higher
+// tier merges `spans[i]` completed buckets of the tier below, so a push
+// costs O(Tiers) at most and RAM stays at Tiers * N buckets no matter how
+// long the session runs.
+
+struct HistoryBucket {
+  int16_t   min;
+  int16_t   max;
+  int16_t   mean;
+};
+
+template <uint8_t Tiers, uint16_t N>
+class TieredHistory {
+  public:
+    TieredHistory(const uint16_t (&spans)[Tiers]) {
+      uint32_t samples = 1;
+      for (uint8_t i = 0; i < Tiers; i++) {
+        this->spans[i] = spans[i];
+        samples *= spans[i];
+        this->samplesPerBucket[i] = samples;
+      }
+      this->clear();
+    }
+
+    void push(int16_t value) {
+      this->merge(0, value, value, value, 1);
+    }
+
+    void clear() {
+      for (uint8_t i = 0; i < Tiers; i++) {
+        this->buckets[i].clear();
+        this->completed[i] = 0;
+        this->acc[i].merged = 0;
+      }
+    }
+
+    static uint8_t tierCount() { return Tiers; }
+
+    // Completed buckets of a tier, oldest first
+    const RingBuffer<HistoryBucket, N> &tier(uint8_t index) const {
+      return this->buckets[index];
+    }
+
+    // Buckets completed in a tier since the last clear(), lets consumers
+    // detect new data without comparing contents
+    uint32_t completedBuckets(uint8_t index) const {
+      return this->completed[index];
+    }
+
+    // Raw samples covered by one bucket of a tier
+    uint32_t bucketSamples(uint8_t index) const {
+      return this->samplesPerBucket[index];
+    }
+
+  private:
+    struct Accumulator {
+      int16_t   min;
+      int16_t   max;
+      int32_t   sum;
+      uint32_t  samples;
+      uint16_t  merged;
+    };
+
+    RingBuffer<HistoryBucket, N>  buckets[Tiers];
+    Accumulator                   acc[Tiers];
+    uint16_t                      spans[Tiers];
+    uint32_t                      samplesPerBucket[Tiers];
+    uint32_t                      completed[Tiers];
+
+    void merge(uint8_t index, int16_t min, int16_t max, int32_t sum, uint32_t samples) {
+      Accumulator &a = this->acc[index];
+      if (a.merged == 0) {
+        a.min = min;
+        a.max = max;
+        a.sum = sum;
+        a.samples = samples;
+      } else {
+        if (min < a.min) a.min = min;
+        if (max > a.max) a.max = max;
+        a.sum += sum;
+        a.samples += samples;
+      }
+
+      if (++a.merged < this->spans[index]) return;
+
+      HistoryBucket bucket;
+      bucket.min = a.min;
+      bucket.max = a.max;
+      bucket.mean = a.sum / (int32_t) a.samples;
+      this->buckets[index].push(bucket);
+      this->completed[index]++;
+      a.merged = 0;
+
+      if (index + 1 < Tiers) {
+        this->merge(index + 1, a.min, a.max, a.sum, a.samples);
+      }
+    }
+};
+
+#endif
@@ -10,13 +10,98 @@ THiNX thx;
 #include <Wire.h>  // Only needed for Arduino 1.6.5 and earlier
 #include "SSD1306.h" // alias for `#include "SSD1306Wire.h"`
 #include "OLEDDisplayUi.h"
+#include "OLEDDisplayText.h"
+#include "OLEDStripChart.h"
 #include "images.h"
 
+#include "Sampler.h"
+#include "Dsp.h"
+#include "RingSeries.h"
+#include "TieredHistory.h"
+#include "ColumnDownsampler.h"
+#include "StatsEngine.h"
+#include "MeasurementFsm.h"
+
 SSD1306  display(0x3c, D5, D6);
 OLEDDisplayUi ui     ( &display );
 
+Sampler sampler(A0, SAMPLER_RATE_HZ);
+
+// Each consumer drains the sampler at its own pace
+SamplerRing::Cursor measure_cursor;   // measurement state, maximum and reset
+SamplerRing::Cursor graph_cursor;     // graph and history
+SamplerRing::Cursor serial_cursor;    // serial streamer
+SamplerRing::Cursor telemetry_cursor; // MQTT publisher
+
+// Mains frequency to reject, 50 Hz in Europe
+#ifndef EAV_MAINS_HZ
+#define EAV_MAINS_HZ 50
+#endif
+
+static_assert(EAV_MAINS_HZ * 2 < SAMPLER_RATE_HZ, "Mains notch must be below the Nyquist frequency");
+
+// Filter chain between the decimator and transform(): drop single-sample
+// spikes, reject mains hum, then smooth what is left.
+constexpr Dsp::BiquadCoeffs mains_notch = Dsp::notch(EAV_MAINS_HZ, SAMPLER_RATE_HZ, 5.0);
+
+Dsp::Median<uint16_t, 5> spike_filter;
+Dsp::Biquad mains_filter(mains_notch);
+Dsp::Ema<2> noise_filter;
+
+uint16_t filter_sample(uint16_t sample) {
+  sample = spike_filter.filter(sample);
+  sample = Dsp::clamp16(mains_filter.filter(sample));
+  return Dsp::clamp16(noise_filter.filter(sample));
+}
+
 int LAST_EAV = 0; // latest measured value
-int graph[128] = {0};
+// Samples per display column of the raw graph and how they are reduced,
+// 4 samples per column show the last ~4 s at 125 Hz
+#ifndef GRAPH_SAMPLES_PER_COLUMN
+#define GRAPH_SAMPLES_PER_COLUMN 4
+#endif
+#ifndef GRAPH_DOWNSAMPLE
+#define GRAPH_DOWNSAMPLE DOWNSAMPLE_MINMAX
+#endif
+
+ColumnDownsampler<DISPLAY_WIDTH, GRAPH_SAMPLES_PER_COLUMN> graph(GRAPH_SAMPLES_PER_COLUMN, GRAPH_DOWNSAMPLE);
+
+// Coarser history of the session: 1 s, 10 s and 1 min buckets
+const uint16_t history_spans[] = { SAMPLER_RATE_HZ, 10, 6 };
+TieredHistory<3, DISPLAY_WIDTH> history(history_spans);
+
+// Resolution shown by the graph and published by telemetry:
+// 0 is the raw graph, 1.. select the history tiers above
+#ifndef GRAPH_TIER
+#define GRAPH_TIER 0
+#endif
+#ifndef TELEMETRY_TIER
+#define TELEMETRY_TIER 2
+#endif
+
+int graph_tier = GRAPH_TIER;
+int telemetry_tier = TELEMETRY_TIER;
+
+// Values shown from the bottom to the top row of the graph: 25 + one level
+// per panel row, the bottom levels are left out. With GRAPH_AUTOSCALE the range follows
+// the values shown instead, never narrower than GRAPH_MIN_SPAN.
+#ifndef GRAPH_MIN
+#define GRAPH_MIN 26
+#endif
+#ifndef GRAPH_MAX
+#define GRAPH_MAX (GRAPH_MIN + DISPLAY_HEIGHT - 1)
+#endif
+#ifndef GRAPH_MIN_SPAN
+#define GRAPH_MIN_SPAN 16
+#endif
+// With GRAPH_HW_SCROLL the SSD1306 shifts the graph pages itself and only
+// the new column is sent. Its direction together with
+// flipScreenVertically() is still to be confirmed on a panel.
+
+// Rendered graph, one column per completed column or bucket of the tier shown
+OLEDStripChart<DISPLAY_WIDTH, DISPLAY_PAGES> chart;
+uint32_t chart_columns = 0; // columns of the tier already in the chart
+uint8_t grid_phase = 0;     // first grid column, with GRAPH_HW_SCROLL it moves with the graph
 
 #define MODE_MEASURE 0
 #define MODE_STIMULATE 1
@@ -24,18 +109,63 @@ int graph[128] = {0};
 #define BUTTON_PIN D4
 #define SIGOUT_PIN D2
 
+int measure = 0;
+
+const int16_t MAX_INT = 1024;
+const int16_t MIN_IN = 10; // (5 is one human noise, 10 is two)
+const int16_t MIN_AP = 110;
+
 int mode = MODE_MEASURE;
 long debounce = 0; // millis until button will be debounced
-bool perform_graph_reset = false; // trigger for graph reset
-long max_result = 0; // measured maximum
-long max_result_time = 0; // time from measured maximum
-long max_result_interval = 0; // interval from measured maximum
-int graph_loop_counter = 0;
+
+// Probe contact detection, thresholds in result units
+const MeasurementThresholds measurement_thresholds = {
+  2,        // weak: probe touches
+  MIN_IN,   // signal: above is a valid reading
+  MAX_INT,  // saturated: short circuit
+  1,        // hysteresis
+  // dwell in samples: idle, contact, measuring, short, released
+  { 2 * SAMPLER_RATE_HZ, 2, 3, 3, 5 }
+};
+
+MeasurementFsm fsm(measurement_thresholds);
+
+// Each consumer follows the measurement events at its own pace
+MeasurementEvents::Cursor session_events;   // graph, history and statistics
+MeasurementEvents::Cursor ui_events;        // overlays
+MeasurementEvents::Cursor telemetry_events; // MQTT publisher
+
+MeasurementState display_state = STATE_IDLE;
+
+// Time since the peak shown by the state overlay, kept in whole seconds
+// so the UI only redraws when the text changes
+bool peak_shown = false;
+uint32_t peak_seconds = 0;
+bool peak_stable = false;
+
+// Statistics of the current contact, window of ~0.5 s
+StatsEngine<64> stats(SAMPLER_RATE_HZ);
+long sampler_stats_time = 0; // last time sampler statistics were reported
+long telemetry_time = 0; // last time telemetry was published
+
+#define SAMPLER_STATS_INTERVAL 10000
+#define TELEMETRY_INTERVAL 5000
+
+// Telemetry aggregate since the last publish
+uint32_t telemetry_bucket = 0; // history buckets already published
+uint32_t telemetry_count = 0;
+int telemetry_min = 0;
+int telemetry_max = 0;
+uint32_t telemetry_sum = 0;
+
+int transform(uint16_t sample);
 
 void measurementOverlay(OLEDDisplay *display, OLEDDisplayUiState* state) {
   display->setTextAlignment(TEXT_ALIGN_RIGHT);
   display->setFont(ArialMT_Plain_16);
-  display->drawString(128, 0, String(LAST_EAV));
+  OLEDDisplayText<8> text;
+  text.add(LAST_EAV);
+  display->drawString(DISPLAY_WIDTH, 0, text.c_str(), text.length());
 }
 
 void stateOverlay(OLEDDisplay *display, OLEDDisplayUiState* state) {
@@ -43,9 +173,14 @@ void stateOverlay(OLEDDisplay *display, OLEDDisplayUiState* state) {
   display->setFont(ArialMT_Plain_10);
 
   if (mode == MODE_MEASURE) {
-    if (max_result_interval) {
-      // show max_result when interval falls...? over-enginnered prototype
-      display->drawString(0, 0, String(max_result_interval/1000) + String("s -") + String(max_result-LAST_EAV) + String("%"));
+    if (display_state == STATE_CONTACT || display_state == STATE_SHORT) {
+      display->drawString(0, 0, MeasurementFsm::stateName(display_state));
+    } else if (peak_shown) {
+      // show time and drop since the maximum
+      OLEDDisplayText<24> text;
+      text.add((unsigned long) peak_seconds).add(F("s -")).addPercent(stats.peak() - LAST_EAV);
+      if (peak_stable) text.add(F(" ="));
+      display->drawString(0, 0, text.c_str(), text.length());
     } else {
       display->drawString(0, 0, F("MEASURE"));
     }
@@ -54,26 +189,20 @@ void stateOverlay(OLEDDisplay *display, OLEDDisplayUiState* state) {
   }
 }
 
-void drawFrame1(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int16_t y) {
-
-  // Draw line [graph]
-  for (int gx = 0; gx < 128; gx++) {
-
-    if ( (gx % 4) == 0 ) {
-      display->setPixel (gx + x, 15);
-      display->setPixel (gx + x, 31);
-      display->setPixel (gx + x, 63);
-    }
-
-    int gy = 64 - (graph[gx] - 25); // 100% - 64 = 36 / 2 = 18 margin - 8 to ignore bottom levels
-    display->setPixel (gx + x, gy + y);
+// Static part of frame 1, drawn once and restored by every clear(). The
+// rows stay below the overlays, inside the band the panel can scroll.
+void drawGrid(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int16_t y) {
+  for (int gx = grid_phase; gx < DISPLAY_WIDTH; gx += 4) {
+    display->setPixel (gx + x, 16);
+    display->setPixel (gx + x, 31);
+    display->setPixel (gx + x, DISPLAY_HEIGHT - 1);
+  }
+}
 
-    // Draw black pixel divider from old history line
-    display->setColor (BLACK);
-    display->setPixel (gx + x + 1, gy + y);
-    display->setColor (WHITE);
+void drawFrame1(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int16_t y) {
 
-  }
+  // Draw line [graph], oldest column on the left
+  chart.draw(display, x, y);
 }
 
 void drawFrame2(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int16_t y) {
@@ -139,6 +268,9 @@ void drawFrame5(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int1
 // frames are the single views that slide in
 FrameCallback frames[] = { drawFrame1, drawFrame2, drawFrame3, drawFrame4, drawFrame5 };
 
+// Backgrounds of the frames, in the same order
+FrameCallback backgrounds[] = { drawGrid, NULL, NULL, NULL, NULL };
+
 // how many frames are there?
 int frameCount = 1;
 
@@ -171,6 +303,21 @@ void setup() {
   pinMode(A0, INPUT);
   pinMode(BUTTON_PIN, INPUT);
 
+  // Acquire A0 at a fixed rate independent of the UI and network loop
+  sampler.attach(measure_cursor);
+  sampler.attach(graph_cursor);
+  sampler.attach(serial_cursor);
+  sampler.attach(telemetry_cursor);
+  sampler.setFilter(filter_sample);
+
+  fsm.events().attach(session_events);
+  fsm.events().attach(ui_events);
+  fsm.events().attach(telemetry_events);
+
+  // Stable when the reading stays within 2 units and 1 unit/s for 1 s
+  stats.setStability(2, 1000, SAMPLER_RATE_HZ);
+  sampler.begin();
+
   /*
   Serial.println("Going into deep sleep for 5 seconds");
   Serial.println(millis());
@@ -187,14 +334,33 @@ void setup() {
   //ui.setIndicatorDirection(LEFT_RIGHT);
   //ui.setFrameAnimation(SLIDE_LEFT); // SLIDE_LEFT, SLIDE_RIGHT, SLIDE_UP, SLIDE_DOWN
   ui.setFrames(frames, frameCount);
+  ui.setFrameBackgrounds(backgrounds);
+
+#ifdef GRAPH_AUTOSCALE
+  chart.setAutoScale(GRAPH_MIN_SPAN);
+#else
+  chart.setRange(GRAPH_MIN, GRAPH_MAX);
+#endif
+#ifdef GRAPH_HW_SCROLL
+  // The overlays stay on the top two pages, the graph and its grid below
+  // them are scrolled by the controller
+  display.setScrollBand(2, DISPLAY_PAGES - 1);
+#endif
   ui.setOverlays(overlays, overlaysCount);
   ui.disableAutoTransition();
   ui.disableAllIndicators();
   ui.disableIndicator();
 
+  // Redraw only for new graph columns and when what the overlays show
+  // changes (see set_shown()), the frame is the same between most samples
+  ui.setRenderOnDemand(true);
+
   // Initialising the UI will init the display too.
   ui.init();
   display.flipScreenVertically();
+  // Frames go out page by page from ui.update(), the sampler and the
+  // network keep running in between
+  display.setAsyncFlush(true);
 }
 
 /*
@@ -247,15 +413,14 @@ Poznámka: Pokud je obvod zapnutý a RST je spojeno s GND (LOW), není možné n
 
 */
 
-int measure = 0;
 
-int MAX_INT = 1024;
-int MIN_IN = 10; // (5 is one human noise, 10 is two)
-int MIN_AP = 110;
+// Samples arrive from the decimator left-justified to 16 bits, with the
+// oversampling gain in the low bits. One result unit is 10 ADC counts.
+#define RESULT_SCALE (10 << SAMPLER_ADC_SHIFT)
 
-int transform(int measure) {
-  if (measure > 1000) return MAX_INT;
-  int result = measure / 10;
+int transform(uint16_t sample) {
+  if (sample > (1000 << SAMPLER_ADC_SHIFT)) return MAX_INT;
+  int result = (sample + RESULT_SCALE / 2) / RESULT_SCALE;
   return result;
 }
 
@@ -272,55 +437,228 @@ String format(int measure) {
 
 
 void reset_graph() {
-  for (int i = 0; i < 128; i++) {
-    graph[i] = 0;
-  }
-  graph_loop_counter = 0;
-  max_result = 0;
-  max_result_time = 0;
-  perform_graph_reset = false;
+  graph.clear();
+  history.clear();
+  chart.clear();
+  chart_columns = 0;
+  ui.invalidate();
+  telemetry_bucket = 0;
+  graph_cursor.skip();
+  stats.reset();
 }
 
 
-void loop() {
+// Change a value the overlays show, redrawing only if it differs
+template <typename T, typename V>
+void set_shown(T &shown, V value) {
+  if (shown == (T) value) return;
+  shown = value;
+  ui.invalidate();
+}
+
+void process_sample(uint16_t sample) {
+
+  measure = sample >> SAMPLER_ADC_SHIFT;
 
-  measure = analogRead(A0);
+  int result = transform(sample);
+  set_shown(LAST_EAV, result);
 
-  // Enable reset when signal falls to zero
-  if (measure < LAST_EAV) {
-    if (measure < MIN_IN) {
-      perform_graph_reset = true;
+  fsm.push(result, millis());
+
+  // A new contact starts a new session, a short does not interrupt one
+  MeasurementEvent event;
+  while (session_events.read(event)) {
+    if (event.state == STATE_MEASURING && event.previous != STATE_SHORT) {
+      reset_graph();
     }
   }
 
-  int result = transform(measure);
+  if (fsm.state() == STATE_MEASURING) {
+    stats.push(result, millis());
+  }
+}
 
-  if (perform_graph_reset && (result - 10 > MIN_IN) ) {
-    reset_graph();
+void handle_ui_events() {
+  MeasurementEvent event;
+  while (ui_events.read(event)) {
+    set_shown(display_state, event.state);
   }
 
-  LAST_EAV = result;
+  uint32_t since = stats.count() ? stats.timeSincePeak(millis()) : 0;
+  set_shown(peak_shown, since != 0);
+  set_shown(peak_seconds, since / 1000);
+  set_shown(peak_stable, stats.stable());
+}
 
-  if (result > MIN_IN) {
+// Scroll the columns completed since the last call into the chart
+void feed_chart() {
+  uint32_t completed;
+  uint16_t size;
+  if (graph_tier == 0) {
+    completed = graph.completedColumns();
+    size = graph.columns().size();
+  } else {
+    completed = history.completedBuckets(graph_tier - 1);
+    size = history.tier(graph_tier - 1).size();
+  }
 
-    Serial.print(result);
-    Serial.print(" > ");
-    Serial.println(format(result));
+  uint32_t fresh = completed - chart_columns;
+  if (fresh > size) fresh = size;
+  uint8_t scrolled = 0;
+  for (uint16_t i = size - fresh; i < size; i++) {
+    if (graph_tier == 0) {
+      const ColumnSpan &span = graph.columns()[i];
+      scrolled += chart.pushSpan(span.low, span.high);
+    } else {
+      const HistoryBucket &bucket = history.tier(graph_tier - 1)[i];
+      scrolled += chart.pushSpan(bucket.min, bucket.max);
+    }
+  }
+  chart_columns = completed;
+  if (fresh) ui.invalidate();
+
+#ifdef GRAPH_HW_SCROLL
+  // The grid moves with the graph like chart paper, a scrolled panel then
+  // only needs the new column
+  if (scrolled % 4) {
+    grid_phase = (grid_phase + 4 - scrolled % 4) % 4;
+    ui.invalidateBackground();
+  }
 
-    if (result > max_result) {
-      max_result = result;
-      max_result_time = millis();
+  // Let the panel move the graph if it is on screen and not sliding
+  OLEDDisplayUiState *state = ui.getUiState();
+  if (scrolled && state->frameState == FIXED && state->currentFrame == 0) {
+    display.scrollBand(scrolled);
+  }
+#else
+  (void) scrolled;
+#endif
+}
+
+void collect_graph() {
+  uint16_t sample;
+  while (graph_cursor.read(sample)) {
+    int result = transform(sample);
+    if (result > MIN_IN) {
+      graph.push(result);
+      history.push(result);
     }
+  }
+  feed_chart();
+}
 
-    max_result_interval = millis() - max_result_time;
 
-    // increase and save graph value
-    graph_loop_counter++;
-    if (graph_loop_counter > 128) {
-      graph_loop_counter = 0;
+void stream_samples() {
+  uint16_t sample;
+  while (serial_cursor.read(sample)) {
+    int result = transform(sample);
+    if (result > MIN_IN) {
+      Serial.print(result);
+      Serial.print(" > ");
+      Serial.println(format(result));
     }
-    graph[graph_loop_counter] = result;
   }
+}
+
+/* Format contact statistics as JSON members for telemetry */
+String format_stats() {
+  char text[96];
+  snprintf(text, sizeof(text), "\"peak\":%d,\"avg\":%d,\"sd\":%u,\"slope\":%d,\"stable\":%s",
+    stats.peak(), stats.mean(), stats.stddev(), stats.slope(), stats.stable() ? "true" : "false");
+  return String(text);
+}
+
+void publish_telemetry() {
+  char message[192];
+
+  // Report every state change right away
+  MeasurementEvent event;
+  while (telemetry_events.read(event)) {
+    snprintf(message, sizeof(message), "{\"eav\":{\"event\":\"%s\",\"from\":\"%s\",\"value\":%d}}",
+      MeasurementFsm::stateName(event.state), MeasurementFsm::stateName(event.previous), event.value);
+    thx.publishStatus(String(message));
+  }
+
+  uint16_t sample;
+  while (telemetry_cursor.read(sample)) {
+    int result = transform(sample);
+    if (telemetry_count == 0 || result < telemetry_min) telemetry_min = result;
+    if (telemetry_count == 0 || result > telemetry_max) telemetry_max = result;
+    telemetry_sum += result;
+    telemetry_count++;
+  }
+
+  if (telemetry_tier == 0) {
+    // Raw samples aggregated over a fixed interval
+    if (millis() - telemetry_time < TELEMETRY_INTERVAL) return;
+    telemetry_time = millis();
+    if (telemetry_count == 0) return;
+
+    snprintf(message, sizeof(message), "{\"eav\":{\"n\":%u,\"min\":%d,\"max\":%d,\"mean\":%u,\"lost\":%u,%s}}",
+      telemetry_count, telemetry_min, telemetry_max, telemetry_sum / telemetry_count, telemetry_cursor.lost, format_stats().c_str());
+  } else {
+    // Publish whenever the selected history tier completes a bucket
+    uint8_t tier = telemetry_tier - 1;
+    uint32_t completed = history.completedBuckets(tier);
+    if (completed == telemetry_bucket) return;
+    telemetry_bucket = completed;
+
+    const HistoryBucket &bucket = history.tier(tier).newest();
+    snprintf(message, sizeof(message), "{\"eav\":{\"s\":%u,\"n\":%u,\"min\":%d,\"max\":%d,\"mean\":%d,\"lost\":%u,%s}}",
+      history.bucketSamples(tier) / SAMPLER_RATE_HZ, telemetry_count, bucket.min, bucket.max, bucket.mean, telemetry_cursor.lost, format_stats().c_str());
+  }
+
+  thx.publishStatus(String(message));
+
+  telemetry_count = 0;
+  telemetry_sum = 0;
+}
+
+void report_sampler_stats() {
+  if (millis() - sampler_stats_time < SAMPLER_STATS_INTERVAL) return;
+  sampler_stats_time = millis();
+
+  SamplerStats sampler_stats;
+  sampler.getStats(sampler_stats);
+  Serial.printf("*EAV: sampler %u Hz, %u samples, %u dropped, jitter max %u us, mean %u us, lost %u/%u/%u/%u\n",
+    sampler_stats.achievedRate, sampler_stats.samples, sampler_stats.dropped, sampler_stats.jitterMax, sampler_stats.jitterMean,
+    measure_cursor.lost, graph_cursor.lost, serial_cursor.lost, telemetry_cursor.lost);
+  sampler.resetStats();
+
+  const OLEDDISPLAY_BUS_STATS &display_stats = display.busStats();
+  Serial.printf("*EAV: display %u frames, %u bytes on wire, %u transactions, frame max %u us, mean %u us\n",
+    display_stats.frames, display_stats.bytes, display_stats.transactions, display_stats.maxFrameMicros,
+    display_stats.frames ? display_stats.totalMicros / display_stats.frames : 0);
+  display.resetBusStats();
+}
+
+// Sleep through the rest of the frame budget, taking the readings that
+// fall due meanwhile. A new measurement ends the sleep early: the idle
+// UI can sleep for over 100 ms and the state machine wants its samples
+// on time.
+void sample_while_waiting(uint32_t ms) {
+  uint32_t start = millis();
+  while (millis() - start < ms) {
+    sampler.poll();
+    if (measure_cursor.available()) return;
+    delay(1);
+  }
+}
+
+void loop() {
+
+  sampler.poll();
+
+  uint16_t sample;
+  while (measure_cursor.read(sample)) {
+    process_sample(sample);
+  }
+
+  handle_ui_events();
+  collect_graph();
+  stream_samples();
+  publish_telemetry();
+  report_sampler_stats();
 
   thx.loop();
 
@@ -338,6 +676,7 @@ void loop() {
          // still pressed
        } else {
          mode = !(bool)mode;
+         ui.invalidate();
          if (mode == MODE_STIMULATE) {
            reset_graph();
            analogWrite(D2, 1000); // start stimulator
@@ -347,6 +686,6 @@ void loop() {
          debounce = millis() + 500;
        }
      }
-     delay(remainingTimeBudget);
+     sample_while_waiting(remainingTimeBudget);
    }
 }
@@ -0,0 +1,117 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <math.h>
+#include "Decimator.h"
+
+// Host cost per output sample of the decimator settings and the noise
+// left on a constant input, against the single reading transform() used
+// before. Times are host nanoseconds, they only compare the settings with
+// each other.
+
+#define BENCH_INPUTS (1UL << 20)
+#define BENCH_LEVEL 512
+#define BENCH_NOISE 8 // peak-to-peak ADC counts
+
+static volatile uint32_t sink;
+
+// Reproducible ADC readings around BENCH_LEVEL
+static uint32_t noise_state;
+
+static uint16_t noisy_reading() {
+  noise_state = noise_state * 1664525UL + 1013904223UL;
+  return BENCH_LEVEL - BENCH_NOISE / 2 + (noise_state >> 16) % (BENCH_NOISE + 1);
+}
+
+// Standard deviation of the outputs in input counts
+static double output_noise(double sum, double squares, uint32_t count) {
+  double mean = sum / count;
+  return sqrt(squares / count - mean * mean);
+}
+
+template <uint8_t RateLog2, uint8_t Order>
+static void bench_decimator() {
+  typedef Decimator<10, RateLog2, Order> Bench;
+  Bench decimator;
+
+  // Inputs drawn up front, only the filter is timed
+  static uint16_t inputs[4096];
+  noise_state = 1;
+  for (uint16_t i = 0; i < 4096; i++) inputs[i] = noisy_reading();
+
+  // Second round timed, the first one warms up caches and clock
+  uint32_t outputs = 0;
+  uint32_t elapsed = 0;
+  uint16_t output;
+  for (uint8_t round = 0; round < 2; round++) {
+    uint32_t checksum = 0;
+    outputs = 0;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < BENCH_INPUTS; i++) {
+      if (decimator.push(inputs[i & 4095], output)) {
+        checksum += output;
+        outputs++;
+      }
+    }
+    elapsed = micros() - start;
+    sink = checksum;
+  }
+
+  // Noise once the integrators are primed, in ADC counts
+  double sum = 0;
+  double squares = 0;
+  uint32_t count = 0;
+  decimator.reset();
+  for (uint32_t i = 0; i < 65536; i++) {
+    if (decimator.push(noisy_reading(), output) && i >= (Bench::RATE << 2)) {
+      double value = (double) output / (1 << (16 - 10));
+      sum += value;
+      squares += value * value;
+      count++;
+    }
+  }
+
+  char message[128];
+  snprintf(message, sizeof(message), "rate %u order %u: %.1f ns per output sample, noise %.3f counts rms",
+    Bench::RATE, Order, elapsed * 1000.0 / outputs, output_noise(sum, squares, count));
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL_UINT32(BENCH_INPUTS / Bench::RATE, outputs);
+  TEST_ASSERT_INT_WITHIN(1, BENCH_LEVEL, (int) (sum / count + 0.5));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_bench_single_reading(void) {
+  double sum = 0;
+  double squares = 0;
+  noise_state = 1;
+  for (uint32_t i = 0; i < 65536; i++) {
+    double value = noisy_reading();
+    sum += value;
+    squares += value * value;
+  }
+  char message[96];
+  snprintf(message, sizeof(message), "single reading: noise %.3f counts rms", output_noise(sum, squares, 65536));
+  TEST_MESSAGE(message);
+}
+
+void test_bench_boxcar(void) {
+  bench_decimator<2, 1>();
+  bench_decimator<3, 1>();
+  bench_decimator<4, 1>();
+}
+
+void test_bench_cic(void) {
+  bench_decimator<3, 2>();
+  bench_decimator<3, 3>();
+  bench_decimator<4, 2>();
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_single_reading);
+  RUN_TEST(test_bench_boxcar);
+  RUN_TEST(test_bench_cic);
+  return UNITY_END();
+}
@@ -0,0 +1,122 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <math.h>
+#include "Dsp.h"
+
+// Host cost per sample of every filter in Dsp.h, plus a check that the
+// compile-time designs do what they are named for. Times are host
+// nanoseconds, they only compare the filters with each other.
+
+#define BENCH_RATE_HZ 125
+#define BENCH_SAMPLES (1UL << 20)
+
+static volatile int32_t sink;
+
+static int32_t inputs[4096];
+
+constexpr Dsp::BiquadCoeffs bench_lowpass = Dsp::lowpass(10, BENCH_RATE_HZ, 0.707);
+constexpr Dsp::BiquadCoeffs bench_notch = Dsp::notch(50, BENCH_RATE_HZ, 5.0);
+
+// Left-justified 16-bit samples like the decimator delivers
+static void fill_inputs() {
+  uint32_t state = 1;
+  for (uint16_t i = 0; i < 4096; i++) {
+    state = state * 1664525UL + 1013904223UL;
+    inputs[i] = 32768 + 8000 * sin(2 * M_PI * 50 * i / BENCH_RATE_HZ) + (int32_t) (state >> 22) - 512;
+  }
+}
+
+template <typename Filter>
+static void bench_filter(const char *name, Filter &filter) {
+  // Second round timed, the first one warms up caches and clock
+  uint32_t elapsed = 0;
+  for (uint8_t round = 0; round < 2; round++) {
+    int32_t checksum = 0;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+      checksum += filter.filter(inputs[i & 4095]);
+    }
+    elapsed = micros() - start;
+    sink = checksum;
+  }
+
+  char message[96];
+  snprintf(message, sizeof(message), "%s: %.1f ns per sample", name, elapsed * 1000.0 / BENCH_SAMPLES);
+  TEST_MESSAGE(message);
+}
+
+// Gain in 1/1000 for a sine of `frequency`, after settling
+static int gain_at(const Dsp::BiquadCoeffs &coeffs, double frequency) {
+  Dsp::Biquad filter(coeffs);
+  double peak = 0;
+  for (uint16_t i = 0; i < 2000; i++) {
+    int32_t y = filter.filter(8000 * sin(2 * M_PI * frequency * i / BENCH_RATE_HZ));
+    if (i >= 1000 && fabs(y) > peak) peak = fabs(y);
+  }
+  return (int) (peak * 1000 / 8000 + 0.5);
+}
+
+// Chain of main.cpp as one filter
+struct Chain {
+  Dsp::Median<uint16_t, 5> spike;
+  Dsp::Biquad mains = Dsp::Biquad(bench_notch);
+  Dsp::Ema<2> noise;
+
+  int32_t filter(int32_t x) {
+    uint16_t sample = spike.filter(Dsp::clamp16(x));
+    sample = Dsp::clamp16(mains.filter(sample));
+    return noise.filter(sample);
+  }
+};
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_bench_biquad(void) {
+  Dsp::Biquad lowpass(bench_lowpass);
+  Dsp::Biquad notch(bench_notch);
+  bench_filter("biquad lowpass", lowpass);
+  bench_filter("biquad notch", notch);
+}
+
+void test_bench_ema(void) {
+  Dsp::Ema<2> ema2;
+  Dsp::Ema<6> ema6;
+  bench_filter("ema 2", ema2);
+  bench_filter("ema 6", ema6);
+}
+
+void test_bench_median(void) {
+  Dsp::Median<int32_t, 5> median5;
+  Dsp::Median<int32_t, 9> median9;
+  bench_filter("median 5", median5);
+  bench_filter("median 9", median9);
+}
+
+void test_bench_chain(void) {
+  Chain chain;
+  bench_filter("spike + notch + ema chain", chain);
+}
+
+void test_notch_rejects_mains(void) {
+  TEST_ASSERT_LESS_THAN(50, gain_at(bench_notch, 50));
+  TEST_ASSERT_INT_WITHIN(20, 1000, gain_at(bench_notch, 5));
+}
+
+void test_lowpass_response(void) {
+  TEST_ASSERT_INT_WITHIN(20, 1000, gain_at(bench_lowpass, 1));
+  TEST_ASSERT_LESS_THAN(200, gain_at(bench_lowpass, 40));
+}
+
+int main(int argc, char **argv) {
+  fill_inputs();
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_biquad);
+  RUN_TEST(test_bench_ema);
+  RUN_TEST(test_bench_median);
+  RUN_TEST(test_bench_chain);
+  RUN_TEST(test_notch_rejects_mains);
+  RUN_TEST(test_lowpass_response);
+  return UNITY_END();
+}
@@ -0,0 +1,247 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "OLEDDisplay.h"
+
+// Word-wide framebuffer kernels against the byte-wise code they replaced,
+// kept below as the reference. Both run on the same random content and
+// have to leave the same bytes behind, and both do the same dirty and
+// content tracking, so only the kernels differ. Times are host nanoseconds
+// per call, they only compare the two versions with each other. The
+// firmware builds at -Os, build with -Os to compare at that level.
+
+#define BENCH_CALLS 20000
+
+// Display without a bus, planFlush() made reachable
+class BenchDisplay : public OLEDDisplay {
+  public:
+    void display(void) {}
+    uint8_t plan() { return planFlush(); }
+
+    // Content on every column of every page, as clear() sees it after a
+    // full-screen frame
+    void touchAll() {
+      for (uint8_t page = 0; page < DISPLAY_PAGES; page++) touch(page, 0, DISPLAY_WIDTH - 1);
+    }
+
+    // The tracking the drawing functions do, for the reference kernels
+    void touchArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1) { touchRect(x0, y0, x1, y1); }
+    void touchRow(uint8_t page, uint8_t x0, uint8_t x1) { touch(page, x0, x1); }
+
+    // What clear() leaves of the tracking without a background layer
+    void cleared() {
+      for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        if (contentMinX[page] > contentMaxX[page]) continue;
+        if (contentMinX[page] < dirtyMinX[page]) dirtyMinX[page] = contentMinX[page];
+        if (contentMaxX[page] > dirtyMaxX[page]) dirtyMaxX[page] = contentMaxX[page];
+        contentMinX[page] = DISPLAY_WIDTH;
+        contentMaxX[page] = 0;
+      }
+    }
+
+  protected:
+    bool connect() { return true; }
+};
+
+static BenchDisplay bench_display;
+static uint8_t reference[DISPLAY_BUFFER_SIZE];
+static uint8_t reference_back[DISPLAY_BUFFER_SIZE];
+static volatile uint32_t sink;
+
+// -/----- Byte-wise reference -----\-
+
+// Kept out of line like the library code, so the compiler cannot merge the
+// repeated calls of the timing loop
+static void __attribute__((noinline)) reference_vertical_line(int16_t x, int16_t y, int16_t length, OLEDDISPLAY_COLOR color) {
+  if (x < 0 || x >= DISPLAY_WIDTH) return;
+  if (y < 0) {
+    length += y;
+    y = 0;
+  }
+  if ((y + length) > DISPLAY_HEIGHT) length = DISPLAY_HEIGHT - y;
+  if (length <= 0) return;
+
+  uint8_t yOffset = y & 7;
+  uint8_t drawBit;
+  uint8_t *bufferPtr = reference + (y >> 3) * DISPLAY_WIDTH + x;
+
+  if (yOffset) {
+    yOffset = 8 - yOffset;
+    drawBit = ~(0xFF >> (yOffset));
+    if (length < yOffset) drawBit &= (0xFF >> (yOffset - length));
+    switch (color) {
+      case WHITE:   *bufferPtr |=  drawBit; break;
+      case BLACK:   *bufferPtr &= ~drawBit; break;
+      case INVERSE: *bufferPtr ^=  drawBit; break;
+    }
+    if (length < yOffset) return;
+    length -= yOffset;
+    bufferPtr += DISPLAY_WIDTH;
+  }
+
+  if (length >= 8) {
+    switch (color) {
+      case WHITE:
+      case BLACK:
+        drawBit = (color == WHITE) ? 0xFF : 0x00;
+        do {
+          *bufferPtr = drawBit;
+          bufferPtr += DISPLAY_WIDTH;
+          length -= 8;
+        } while (length >= 8);
+        break;
+      case INVERSE:
+        do {
+          *bufferPtr = ~(*bufferPtr);
+          bufferPtr += DISPLAY_WIDTH;
+          length -= 8;
+        } while (length >= 8);
+        break;
+    }
+  }
+
+  if (length > 0) {
+    drawBit = (1 << (length & 7)) - 1;
+    switch (color) {
+      case WHITE:   *bufferPtr |=  drawBit; break;
+      case BLACK:   *bufferPtr &= ~drawBit; break;
+      case INVERSE: *bufferPtr ^=  drawBit; break;
+    }
+  }
+}
+
+static void __attribute__((noinline)) reference_fill_rect(int16_t xMove, int16_t yMove, int16_t width, int16_t height, OLEDDISPLAY_COLOR color) {
+  for (int16_t x = xMove; x < xMove + width; x++) {
+    reference_vertical_line(x, yMove, height, color);
+  }
+}
+
+static void __attribute__((noinline)) reference_horizontal_line(int16_t x, int16_t y, int16_t length) {
+  uint8_t *bufferPtr = reference + (y >> 3) * DISPLAY_WIDTH + x;
+  uint8_t drawBit = 1 << (y & 7);
+  while (length--) {
+    *bufferPtr++ |= drawBit;
+  }
+}
+
+static uint32_t __attribute__((noinline)) reference_compare() {
+  uint32_t gap = 0;
+  for (uint16_t i = 0; i < DISPLAY_BUFFER_SIZE; i++) {
+    if (reference[i] == reference_back[i]) {
+      gap++;
+      continue;
+    }
+    reference_back[i] = reference[i];
+  }
+  return gap;
+}
+
+// -/----- Harness -----\-
+
+static void fill_random() {
+  uint32_t state = 1;
+  for (uint16_t i = 0; i < DISPLAY_BUFFER_SIZE; i++) {
+    state = state * 1664525UL + 1013904223UL;
+    reference[i] = bench_display.buffer[i] = state >> 24;
+  }
+}
+
+// Time BENCH_CALLS calls of both versions and check they agree
+template <typename Library, typename Reference>
+static void bench(const char *name, Library library, Reference reference_call) {
+  fill_random();
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < BENCH_CALLS; i++) {
+    library();
+    asm volatile("" ::: "memory");
+  }
+  uint32_t libraryTime = micros() - start;
+
+  start = micros();
+  for (uint32_t i = 0; i < BENCH_CALLS; i++) {
+    reference_call();
+    asm volatile("" ::: "memory");
+  }
+  uint32_t referenceTime = micros() - start;
+
+  char message[128];
+  snprintf(message, sizeof(message), "%s: %.0f -> %.0f ns (%.1fx)", name,
+    referenceTime * 1000.0 / BENCH_CALLS, libraryTime * 1000.0 / BENCH_CALLS,
+    libraryTime ? (double) referenceTime / libraryTime : 0);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL_MEMORY_MESSAGE(reference, bench_display.buffer, DISPLAY_BUFFER_SIZE, name);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_bench_fill_rect(void) {
+  bench("fillRect full screen", [] {
+    bench_display.setColor(WHITE);
+    bench_display.fillRect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  }, [] {
+    bench_display.touchArea(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    reference_fill_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, WHITE);
+  });
+}
+
+void test_bench_fill_rect_inverse(void) {
+  bench("fillRect 117x50 INVERSE", [] {
+    bench_display.setColor(INVERSE);
+    bench_display.fillRect(5, 3, 117, 50);
+  }, [] {
+    bench_display.touchArea(5, 3, 5 + 117 - 1, 3 + 50 - 1);
+    reference_fill_rect(5, 3, 117, 50, INVERSE);
+  });
+}
+
+void test_bench_horizontal_lines(void) {
+  bench("64 full-width horizontal lines", [] {
+    bench_display.setColor(WHITE);
+    for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) bench_display.drawHorizontalLine(0, y, DISPLAY_WIDTH);
+  }, [] {
+    for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+      bench_display.touchRow(y >> 3, 0, DISPLAY_WIDTH - 1);
+      reference_horizontal_line(0, y, DISPLAY_WIDTH);
+    }
+  });
+}
+
+void test_bench_clear(void) {
+  bench("clear full screen", [] {
+    bench_display.touchAll();
+    bench_display.clear();
+  }, [] {
+    bench_display.touchAll();
+    memset(reference, 0, DISPLAY_BUFFER_SIZE);
+    bench_display.cleared();
+  });
+}
+
+void test_bench_compare(void) {
+  // Unchanged frame, everything marked dirty: only the comparison runs
+  fill_random();
+  bench_display.markDirty();
+  bench_display.plan();
+  memcpy(reference_back, reference, DISPLAY_BUFFER_SIZE);
+
+  bench("compare unchanged full screen", [] {
+    bench_display.markDirty();
+    sink = bench_display.plan();
+  }, [] {
+    bench_display.markDirty();
+    sink = reference_compare();
+  });
+}
+
+int main(int argc, char **argv) {
+  bench_display.init();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_fill_rect);
+  RUN_TEST(test_bench_fill_rect_inverse);
+  RUN_TEST(test_bench_horizontal_lines);
+  RUN_TEST(test_bench_clear);
+  RUN_TEST(test_bench_compare);
+  return UNITY_END();
+}
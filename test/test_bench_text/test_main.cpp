@@ -0,0 +1,100 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "OLEDDisplay.h"
+
+// drawString() throughput in glyphs per millisecond, page aligned and
+// across pages, with the glyph cache OLEDDISPLAY_GLYPH_CACHE sets. Build
+// once more with -D OLEDDISPLAY_GLYPH_CACHE=0 to compare against flash
+// lookups. Host pgm_read_byte() is a plain load, on the ESP8266 every
+// uncached char costs four aligned flash reads, so the host gap is the
+// lower bound.
+
+#define BENCH_STRINGS 20000
+#define BENCH_ROUNDS 7
+
+static const char bench_text[] = "Interval 1234 ms 56%";
+
+// Display without a bus
+class BenchDisplay : public OLEDDisplay {
+  public:
+    void display(void) {}
+
+  protected:
+    bool connect() { return true; }
+};
+
+static BenchDisplay bench_display;
+static volatile uint32_t sink;
+
+static void bench_font(const char *name, const char *font, int16_t y) {
+  bench_display.setFont(font);
+  bench_display.setColor(WHITE);
+  uint16_t glyphs = strlen(bench_text);
+
+  // Fastest of a few rounds, the host is shared with other processes
+  uint32_t elapsed = UINT32_MAX;
+  for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < BENCH_STRINGS; i++) {
+      bench_display.clear();
+      bench_display.drawString(0, y, bench_text);
+    }
+    elapsed = _min(elapsed, micros() - start);
+  }
+
+  uint32_t ink = 0;
+  for (uint16_t i = 0; i < DISPLAY_BUFFER_SIZE; i++) ink += bench_display.buffer[i];
+  sink = ink;
+  TEST_ASSERT_GREATER_THAN(0, ink);
+
+  char message[128];
+  snprintf(message, sizeof(message), "%s, y=%d, cache %d: %.1fk glyphs/ms", name, y,
+    OLEDDISPLAY_GLYPH_CACHE, (double) BENCH_STRINGS * glyphs / elapsed);
+  TEST_MESSAGE(message);
+}
+
+static void bench_width(const char *name, const char *font) {
+  bench_display.setFont(font);
+  uint16_t glyphs = strlen(bench_text);
+
+  uint32_t elapsed = UINT32_MAX;
+  for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+    uint32_t width = 0;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < BENCH_STRINGS; i++) {
+      width += bench_display.getStringWidth(bench_text);
+    }
+    elapsed = _min(elapsed, micros() - start);
+    sink = width;
+  }
+
+  char message[128];
+  snprintf(message, sizeof(message), "getStringWidth %s, cache %d: %.1fk glyphs/ms", name,
+    OLEDDISPLAY_GLYPH_CACHE, elapsed ? (double) BENCH_STRINGS * glyphs / elapsed : 0);
+  TEST_MESSAGE(message);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_bench_draw_string(void) {
+  bench_font("ArialMT_Plain_10", ArialMT_Plain_10, 0);
+  bench_font("ArialMT_Plain_10", ArialMT_Plain_10, 3);
+  bench_font("ArialMT_Plain_16", ArialMT_Plain_16, 0);
+  bench_font("ArialMT_Plain_16", ArialMT_Plain_16, 3);
+}
+
+void test_bench_string_width(void) {
+  bench_width("ArialMT_Plain_10", ArialMT_Plain_10);
+  bench_width("ArialMT_Plain_16", ArialMT_Plain_16);
+}
+
+int main(int argc, char **argv) {
+  bench_display.init();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_draw_string);
+  RUN_TEST(test_bench_string_width);
+  return UNITY_END();
+}
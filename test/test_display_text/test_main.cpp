@@ -0,0 +1,46 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <limits.h>
+#include "OLEDDisplayText.h"
+
+// Stack-built texts, including the widest numbers `long` holds on this
+// platform (64 bits in the native build)
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_numbers_and_percent(void) {
+  OLEDDisplayText<16> text;
+  text.add(12).add("s -").addPercent(-5);
+  TEST_ASSERT_EQUAL_STRING("12s --5%", text.c_str());
+  TEST_ASSERT_EQUAL(8, text.length());
+}
+
+void test_widest_numbers(void) {
+  char expected[64];
+  OLEDDisplayText<64> text;
+
+  snprintf(expected, sizeof(expected), "%lu", ULONG_MAX);
+  text.add(ULONG_MAX);
+  TEST_ASSERT_EQUAL_STRING(expected, text.c_str());
+
+  snprintf(expected, sizeof(expected), "%ld", LONG_MIN);
+  text.clear().add(LONG_MIN);
+  TEST_ASSERT_EQUAL_STRING(expected, text.c_str());
+}
+
+void test_cut_off_when_full(void) {
+  OLEDDisplayText<5> text;
+  text.add(123456L);
+  TEST_ASSERT_EQUAL_STRING("1234", text.c_str());
+  TEST_ASSERT_EQUAL(4, text.length());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_numbers_and_percent);
+  RUN_TEST(test_widest_numbers);
+  RUN_TEST(test_cut_off_when_full);
+  return UNITY_END();
+}
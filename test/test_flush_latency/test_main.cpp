@@ -0,0 +1,85 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <Wire.h>
+#include "SSD1306Wire.h"
+#include "OLEDDisplayUi.h"
+
+// Time from rendering a frame until its asynchronous flush is on the
+// panel, with loop() waiting out the budget update() returns like
+// main.cpp does. A flush sends one page per update(), so any sleep
+// between its pages multiplies the latency by the page count.
+
+#define TEST_FPS 30
+
+static SSD1306Wire test_display(0x3c, D5, D6);
+static OLEDDisplayUi test_ui(&test_display);
+
+static uint32_t frames_drawn;
+static uint32_t render_time;
+
+// Every frame changes every page
+static void drawStripes(OLEDDisplay *display, OLEDDisplayUiState *state, int16_t x, int16_t y) {
+  display->setColor(WHITE);
+  for (int16_t column = frames_drawn & 1; column < DISPLAY_WIDTH; column += 2) {
+    display->drawVerticalLine(x + column, y, DISPLAY_HEIGHT);
+  }
+  frames_drawn++;
+  render_time = millis();
+}
+
+static FrameCallback test_frames[] = { drawStripes };
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_flush_latency_within_a_frame(void) {
+  uint32_t flushes = 0;
+  uint32_t latency_max = 0;
+  uint32_t latency_sum = 0;
+  uint32_t updates = 0;
+  uint32_t updates_max = 0;
+  uint32_t pending_since = 0;
+
+  uint32_t start = millis();
+  while (millis() - start < 1000) {
+    uint32_t frames = frames_drawn;
+    int remainingTimeBudget = test_ui.update();
+    if (frames_drawn != frames) pending_since = render_time;
+    updates++;
+
+    if (pending_since && !test_display.flushInProgress()) {
+      uint32_t latency = millis() - pending_since;
+      latency_max = _max(latency_max, latency);
+      latency_sum += latency;
+      updates_max = _max(updates_max, updates);
+      flushes++;
+      pending_since = 0;
+      updates = 0;
+    }
+    if (remainingTimeBudget > 0) delay(remainingTimeBudget);
+  }
+
+  char message[128];
+  snprintf(message, sizeof(message), "%u flushes, latency max %u ms, mean %u ms, up to %u update() calls each",
+    flushes, latency_max, flushes ? latency_sum / flushes : 0, updates_max);
+  TEST_MESSAGE(message);
+
+  // Only meaningful if a flush needs several calls
+  TEST_ASSERT_GREATER_THAN(1, updates_max);
+  TEST_ASSERT_GREATER_THAN(TEST_FPS / 2, flushes);
+  TEST_ASSERT_LESS_THAN(1000 / TEST_FPS, latency_max);
+}
+
+int main(int argc, char **argv) {
+  test_ui.setTargetFPS(TEST_FPS);
+  test_ui.setFrames(test_frames, 1);
+  test_ui.disableAllIndicators();
+  test_ui.disableAutoTransition();
+  test_ui.init();
+  test_display.setAsyncFlush(true);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_flush_latency_within_a_frame);
+  return UNITY_END();
+}
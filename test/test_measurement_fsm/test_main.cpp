@@ -0,0 +1,126 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "MeasurementFsm.h"
+
+// Transitions of the measurement detector, driven sample by sample
+
+static const MeasurementThresholds test_thresholds = {
+  2,        // weak
+  10,       // signal
+  1000,     // saturated
+  1,        // hysteresis
+  // dwell: idle, contact, measuring, short, released
+  { 4, 2, 3, 3, 5 }
+};
+
+static MeasurementFsm *fsm;
+static MeasurementEvents::Cursor events;
+static uint32_t now;
+
+// Push `count` samples of `value`, returns the number of state changes
+static uint8_t push(int16_t value, uint16_t count) {
+  uint8_t changes = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    if (fsm->push(value, now++)) changes++;
+  }
+  return changes;
+}
+
+static void assert_event(MeasurementState state, MeasurementState previous, int16_t value) {
+  MeasurementEvent event;
+  TEST_ASSERT_TRUE(events.read(event));
+  TEST_ASSERT_EQUAL(state, event.state);
+  TEST_ASSERT_EQUAL(previous, event.previous);
+  TEST_ASSERT_EQUAL_INT16(value, event.value);
+}
+
+void setUp(void) {
+  fsm = new MeasurementFsm(test_thresholds);
+  fsm->events().attach(events);
+  now = 0;
+}
+
+void tearDown(void) {
+  delete fsm;
+}
+
+void test_idle_without_input(void) {
+  TEST_ASSERT_EQUAL(0, push(0, 100));
+  TEST_ASSERT_EQUAL(STATE_IDLE, fsm->state());
+  TEST_ASSERT_EQUAL(0, events.available());
+}
+
+void test_contact_then_measuring(void) {
+  TEST_ASSERT_EQUAL(0, push(5, 1));
+  TEST_ASSERT_EQUAL(1, push(5, 1));
+  TEST_ASSERT_EQUAL(STATE_CONTACT, fsm->state());
+  assert_event(STATE_CONTACT, STATE_IDLE, 5);
+
+  TEST_ASSERT_EQUAL(0, push(50, 2));
+  TEST_ASSERT_EQUAL(1, push(50, 1));
+  TEST_ASSERT_EQUAL(STATE_MEASURING, fsm->state());
+  assert_event(STATE_MEASURING, STATE_CONTACT, 50);
+}
+
+void test_release_falls_back_to_idle(void) {
+  push(50, 3);
+  TEST_ASSERT_EQUAL(STATE_MEASURING, fsm->state());
+  assert_event(STATE_MEASURING, STATE_IDLE, 50);
+
+  TEST_ASSERT_EQUAL(0, push(0, 4));
+  TEST_ASSERT_EQUAL(1, push(0, 1));
+  TEST_ASSERT_EQUAL(STATE_RELEASED, fsm->state());
+  assert_event(STATE_RELEASED, STATE_MEASURING, 0);
+
+  TEST_ASSERT_EQUAL(1, push(0, 4));
+  TEST_ASSERT_EQUAL(STATE_IDLE, fsm->state());
+  assert_event(STATE_IDLE, STATE_RELEASED, 0);
+}
+
+void test_short_circuit(void) {
+  push(50, 3);
+  TEST_ASSERT_EQUAL(1, push(1000, 3));
+  TEST_ASSERT_EQUAL(STATE_SHORT, fsm->state());
+
+  // Back below the saturation level it measures again
+  TEST_ASSERT_EQUAL(1, push(50, 3));
+  TEST_ASSERT_EQUAL(STATE_MEASURING, fsm->state());
+}
+
+void test_dwell_restarts_when_interrupted(void) {
+  push(5, 1);
+  push(0, 1);
+  TEST_ASSERT_EQUAL(0, push(5, 1));
+  TEST_ASSERT_EQUAL(STATE_IDLE, fsm->state());
+}
+
+void test_hysteresis_holds_contact(void) {
+  push(5, 2);
+  TEST_ASSERT_EQUAL(STATE_CONTACT, fsm->state());
+
+  // Within the hysteresis below the weak level contact is kept
+  TEST_ASSERT_EQUAL(0, push(1, 20));
+  TEST_ASSERT_EQUAL(STATE_CONTACT, fsm->state());
+
+  TEST_ASSERT_EQUAL(1, push(0, 4));
+  TEST_ASSERT_EQUAL(STATE_IDLE, fsm->state());
+}
+
+void test_reset(void) {
+  push(50, 3);
+  fsm->reset();
+  TEST_ASSERT_EQUAL(STATE_IDLE, fsm->state());
+  TEST_ASSERT_EQUAL(0, push(0, 10));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_idle_without_input);
+  RUN_TEST(test_contact_then_measuring);
+  RUN_TEST(test_release_falls_back_to_idle);
+  RUN_TEST(test_short_circuit);
+  RUN_TEST(test_dwell_restarts_when_interrupted);
+  RUN_TEST(test_hysteresis_holds_contact);
+  RUN_TEST(test_reset);
+  return UNITY_END();
+}
@@ -0,0 +1,90 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <Wire.h>
+#include "SSD1306Wire.h"
+#include "OLEDDisplayUi.h"
+
+// Rendering on demand: update() has to draw only what was invalidated or
+// watched, and tell loop() how long it may sleep until then.
+
+#define TEST_FPS 30
+#define TEST_INTERVAL (1000 / TEST_FPS)
+
+static SSD1306Wire test_display(0x3c, D5, D6);
+static OLEDDisplayUi test_ui(&test_display);
+
+static uint32_t frames_drawn;
+static uint32_t test_value;
+
+static void drawValue(OLEDDisplay *display, OLEDDisplayUiState *state, int16_t x, int16_t y) {
+  display->drawString(x, y, String(test_value));
+  frames_drawn++;
+}
+
+static FrameCallback test_frames[] = { drawValue };
+
+// Run loop() like main.cpp for `ms`, returns the longest sleep update() allowed
+static int run_loop(uint32_t ms) {
+  int sleep_max = 0;
+  uint32_t start = millis();
+  while (millis() - start < ms) {
+    int remainingTimeBudget = test_ui.update();
+    sleep_max = _max(sleep_max, remainingTimeBudget);
+    if (remainingTimeBudget > 0) delay(_min((uint32_t) remainingTimeBudget, ms - (millis() - start)));
+  }
+  return sleep_max;
+}
+
+void setUp(void) {
+  // Settle on the first frame
+  run_loop(100);
+  frames_drawn = 0;
+}
+
+void tearDown(void) {}
+
+void test_idle_sleeps_longer_than_a_frame(void) {
+  int sleep_max = run_loop(500);
+  TEST_ASSERT_EQUAL(0, frames_drawn);
+  TEST_ASSERT_GREATER_THAN(TEST_INTERVAL, sleep_max);
+}
+
+void test_invalidate_draws_once(void) {
+  test_value++;
+  test_ui.invalidate();
+  // Drawn by the next tick, not after the idle sleep
+  run_loop(TEST_INTERVAL + 5);
+  TEST_ASSERT_EQUAL(1, frames_drawn);
+  run_loop(300);
+  TEST_ASSERT_EQUAL(1, frames_drawn);
+}
+
+// Last, a watch cannot be removed
+void test_watch_keeps_the_frame_interval(void) {
+  test_ui.watch(&test_value, sizeof(test_value));
+  run_loop(100);
+  frames_drawn = 0;
+
+  int sleep_max = run_loop(300);
+  TEST_ASSERT_EQUAL(0, frames_drawn);
+  TEST_ASSERT_LESS_OR_EQUAL(TEST_INTERVAL, sleep_max);
+
+  test_value++;
+  run_loop(100);
+  TEST_ASSERT_EQUAL(1, frames_drawn);
+}
+
+int main(int argc, char **argv) {
+  test_ui.setTargetFPS(TEST_FPS);
+  test_ui.setFrames(test_frames, 1);
+  test_ui.disableAllIndicators();
+  test_ui.disableAutoTransition();
+  test_ui.setRenderOnDemand(true);
+  test_ui.init();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_idle_sleeps_longer_than_a_frame);
+  RUN_TEST(test_invalidate_draws_once);
+  RUN_TEST(test_watch_keeps_the_frame_interval);
+  return UNITY_END();
+}
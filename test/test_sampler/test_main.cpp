@@ -0,0 +1,90 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "NativeHost.h"
+#include "Sampler.h"
+
+// The host sampler counts its periods against the real clock, so a loop
+// that polls too rarely shows up in the statistics like it does on the
+// device.
+
+#define TEST_ADC_VALUE 512
+#define TEST_PERIOD_US (1000000UL / (SAMPLER_RATE_HZ << SAMPLER_OVERSAMPLE_LOG2))
+
+static Sampler test_sampler(A0, SAMPLER_RATE_HZ);
+static SamplerRing::Cursor test_cursor;
+
+static int constant_input(uint8_t pin) {
+  return TEST_ADC_VALUE;
+}
+
+// Poll every `interval` us for `duration` ms
+static void poll_for(uint32_t duration, uint32_t interval) {
+  uint32_t start = millis();
+  while (millis() - start < duration) {
+    test_sampler.poll();
+    delayMicroseconds(interval);
+  }
+}
+
+void setUp(void) {
+  nativeSetAnalogSource(constant_input);
+  test_sampler.begin();
+}
+
+void tearDown(void) {
+  test_sampler.end();
+}
+
+void test_sampler_keeps_rate_when_polled(void) {
+  // The test process itself can be preempted for longer than the sampler
+  // catches up on, a window without drops is the one that counts
+  SamplerStats stats;
+  for (uint8_t attempt = 0; attempt < 3; attempt++) {
+    test_sampler.end();
+    test_sampler.begin();
+    poll_for(200, TEST_PERIOD_US / 4);
+    test_sampler.getStats(stats);
+    if (stats.dropped == 0) break;
+  }
+
+  uint32_t expected = 200000UL / TEST_PERIOD_US;
+  TEST_ASSERT_INT_WITHIN(expected / 10, expected, stats.samples);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.dropped);
+  TEST_ASSERT_LESS_THAN(SAMPLER_CATCH_UP * TEST_PERIOD_US, stats.jitterMax);
+}
+
+void test_sampler_reports_stall(void) {
+  poll_for(20, TEST_PERIOD_US / 4);
+  delay(50);
+  test_sampler.poll();
+
+  // The periods of the stall beyond SAMPLER_CATCH_UP are dropped, the
+  // oldest reading still taken is late by all of the ones after it
+  SamplerStats stats;
+  test_sampler.getStats(stats);
+  uint32_t stalled = 50000UL / TEST_PERIOD_US;
+  TEST_ASSERT_GREATER_OR_EQUAL(stalled - SAMPLER_CATCH_UP - 1, stats.dropped);
+  TEST_ASSERT_GREATER_OR_EQUAL((SAMPLER_CATCH_UP - 1) * TEST_PERIOD_US, stats.jitterMax);
+}
+
+void test_sampler_decimates_input(void) {
+  test_sampler.attach(test_cursor);
+  poll_for(100, TEST_PERIOD_US / 4);
+
+  SamplerStats stats;
+  test_sampler.getStats(stats);
+  TEST_ASSERT_INT_WITHIN(1, stats.samples >> SAMPLER_OVERSAMPLE_LOG2, test_cursor.available());
+
+  uint16_t sample;
+  while (test_cursor.read(sample)) {
+    TEST_ASSERT_EQUAL_UINT16(TEST_ADC_VALUE << SAMPLER_ADC_SHIFT, sample);
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sampler_keeps_rate_when_polled);
+  RUN_TEST(test_sampler_reports_stall);
+  RUN_TEST(test_sampler_decimates_input);
+  return UNITY_END();
+}
@@ -0,0 +1,233 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <Wire.h>
+#include "NativeHost.h"
+#include "SSD1306Wire.h"
+#include "OLEDStripChart.h"
+
+// Hardware scrolling of a page band, checked against a model of the
+// SSD1306 RAM fed from the I2C bus. After every flush the modelled RAM has
+// to match the frame buffer, whether the band scrolled or not. The model
+// shifts RAM columns, how the panel shows them with segment remap
+// (flipScreenVertically()) is up to the controller and not covered here.
+
+#define TEST_BAND_FIRST 2
+#define TEST_FRAMES 60
+
+// -/----- SSD1306 RAM model -----\-
+
+struct TestPanel {
+  uint8_t ram[DISPLAY_PAGES][128];
+  uint8_t command[8];
+  uint8_t commandLength;
+  uint8_t commandNeeds;
+  uint8_t addressing;
+  uint8_t columnStart, columnEnd, pageStart, pageEnd;
+  uint8_t column, page;
+  uint32_t scrolls;
+  uint32_t dataBytes;
+
+  void reset() {
+    memset(this, 0, sizeof(*this));
+    memset(ram, 0xAA, sizeof(ram));
+    columnEnd = 127;
+    pageEnd = DISPLAY_PAGES - 1;
+  }
+
+  // Argument bytes of the commands the drivers send
+  static uint8_t arguments(uint8_t code) {
+    switch (code) {
+      case 0x21: case 0x22: case 0xA3:
+        return 2;
+      case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+      case 0x26: case 0x27: case 0x2C: case 0x2D:
+        return 6;
+      case 0x29: case 0x2A:
+        return 5;
+      default:
+        return 0;
+    }
+  }
+
+  void onCommand(uint8_t byte) {
+    if (commandNeeds) {
+      command[commandLength++] = byte;
+      if (--commandNeeds == 0) run();
+      return;
+    }
+    command[0] = byte;
+    commandLength = 1;
+    commandNeeds = arguments(byte);
+    if (!commandNeeds) run();
+  }
+
+  void run() {
+    uint8_t code = command[0];
+    if (code == 0x20) addressing = command[1];
+    else if (code == 0x21) { columnStart = column = command[1] & 127; columnEnd = command[2] & 127; }
+    else if (code == 0x22) { pageStart = page = command[1] & 7; pageEnd = command[2] & 7; }
+    else if (code >= 0xB0 && code <= 0xB7) page = code & 7;
+    else if (code <= 0x0F) column = (column & 0xF0) | code;
+    else if (code >= 0x10 && code <= 0x1F) column = (column & 0x0F) | ((code & 0x0F) << 4);
+    else if (code == 0x2D) {
+      // Left by one column, the exposed column is left undefined
+      scrolls++;
+      uint8_t first = command[2] & 7, last = command[4] & 7;
+      uint8_t start = command[5] & 127, end = command[6] & 127;
+      for (uint8_t p = first; p <= last && p < DISPLAY_PAGES; p++) {
+        memmove(&ram[p][start], &ram[p][start + 1], end - start);
+        ram[p][end] = 0x55;
+      }
+    }
+  }
+
+  void onData(uint8_t byte) {
+    dataBytes++;
+    if (page < DISPLAY_PAGES) ram[page][column] = byte;
+    if (addressing == 0) {
+      if (column == columnEnd) {
+        column = columnStart;
+        page = page == pageEnd ? pageStart : page + 1;
+      } else {
+        column++;
+      }
+    } else {
+      column = (column + 1) & 127;
+    }
+  }
+};
+
+static TestPanel panel;
+
+static void listener(uint8_t address, const uint8_t *data, size_t length) {
+  size_t i = 0;
+  while (i < length) {
+    uint8_t control = data[i++];
+    bool single = control & 0x80;
+    bool isData = control & 0x40;
+    do {
+      if (i == length) break;
+      if (isData) panel.onData(data[i]);
+      else panel.onCommand(data[i]);
+      i++;
+    } while (!single);
+  }
+}
+
+// -/----- Harness -----\-
+
+static SSD1306Wire test_display(0x3c, D5, D6);
+static OLEDStripChart<DISPLAY_WIDTH, DISPLAY_PAGES - TEST_BAND_FIRST> test_chart;
+static uint32_t test_value;
+
+static bool panel_matches() {
+  for (uint8_t p = 0; p < DISPLAY_PAGES; p++) {
+    if (memcmp(panel.ram[p], test_display.buffer + p * DISPLAY_WIDTH, DISPLAY_WIDTH)) return false;
+  }
+  return true;
+}
+
+// Draw a frame with a new chart column, returns true if the band moved
+static bool draw_frame(uint32_t frame) {
+  test_value = test_value * 1664525UL + 1013904223UL;
+  bool scrolled = test_chart.push((test_value >> 24) % 48);
+  test_display.clear();
+  test_display.setColor(WHITE);
+  test_display.drawString(0, 0, String(frame));
+  test_chart.draw(&test_display, 0, TEST_BAND_FIRST * 8);
+  return scrolled;
+}
+
+// Fill the chart, then scroll it frame by frame
+static void run_frames(bool flipped) {
+  panel.reset();
+  test_value = 1;
+  test_chart.clear();
+  test_chart.setRange(0, 47);
+  test_display.init();
+  if (flipped) test_display.flipScreenVertically();
+  test_display.setScrollBand(TEST_BAND_FIRST, DISPLAY_PAGES - 1);
+
+  for (uint8_t i = 0; i < DISPLAY_WIDTH; i++) draw_frame(0);
+  test_display.display();
+  TEST_ASSERT_TRUE(panel_matches());
+
+  uint32_t scrolled = 0;
+  uint32_t dataBytes = panel.dataBytes;
+  for (uint32_t frame = 1; frame <= TEST_FRAMES; frame++) {
+    if (draw_frame(frame)) {
+      test_display.scrollBand();
+      scrolled++;
+    }
+    delay(OLEDDISPLAY_SCROLL_INTERVAL);
+    test_display.display();
+    TEST_ASSERT_TRUE_MESSAGE(panel_matches(), "panel RAM differs from the buffer");
+  }
+  dataBytes = panel.dataBytes - dataBytes;
+
+  char message[128];
+  snprintf(message, sizeof(message), "%s: %u scroll steps, %u data bytes per frame",
+    flipped ? "flipped" : "normal", panel.scrolls, dataBytes / TEST_FRAMES);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL(TEST_FRAMES, scrolled);
+  TEST_ASSERT_EQUAL(TEST_FRAMES, panel.scrolls);
+  // The new column and the frame number, not the whole band
+  TEST_ASSERT_LESS_THAN(DISPLAY_WIDTH, dataBytes / TEST_FRAMES);
+}
+
+void setUp(void) {}
+
+// Every test starts from init()
+void tearDown(void) {
+  test_display.end();
+}
+
+void test_scroll_band(void) {
+  run_frames(false);
+}
+
+void test_scroll_band_flipped(void) {
+  run_frames(true);
+}
+
+void test_needless_scroll_keeps_panel(void) {
+  panel.reset();
+  test_display.init();
+  test_display.setScrollBand(TEST_BAND_FIRST, DISPLAY_PAGES - 1);
+
+  // Nothing moved, the flush has to undo the step
+  for (uint8_t frame = 0; frame < 10; frame++) {
+    test_display.clear();
+    test_display.fillRect(frame * 3, TEST_BAND_FIRST * 8, 5, 20);
+    test_display.scrollBand();
+    delay(OLEDDISPLAY_SCROLL_INTERVAL);
+    test_display.display();
+    TEST_ASSERT_TRUE(panel_matches());
+  }
+  TEST_ASSERT_GREATER_THAN(0, panel.scrolls);
+}
+
+void test_steps_too_close_are_sent_normally(void) {
+  run_frames(false);
+
+  uint32_t scrolls = panel.scrolls;
+  for (uint8_t frame = 0; frame < 10; frame++) {
+    if (draw_frame(frame)) test_display.scrollBand();
+    test_display.display();
+    TEST_ASSERT_TRUE(panel_matches());
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(scrolls + 1, panel.scrolls);
+}
+
+int main(int argc, char **argv) {
+  nativeSetI2CListener(listener);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_scroll_band);
+  RUN_TEST(test_scroll_band_flipped);
+  RUN_TEST(test_needless_scroll_keeps_panel);
+  RUN_TEST(test_steps_too_close_are_sent_normally);
+  return UNITY_END();
+}